@@ -2,13 +2,21 @@
 #define API_GNSS_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+// Largo máximo de una sentencia NMEA 0183 entre '$' y "\r\n"
+#define NMEA_MAX_SENTENCE 82
+// Campos que se registran por sentencia (GSV, la más larga, tiene 20)
+#define NMEA_MAX_FIELDS 24
+// Tipos de sentencia con contadores propios; los que no entran se suman a la entrada sin tipo
+#define NMEA_STATS_TYPES 12
+
 typedef struct
 {
 
-    float latitude;
-    float longitude;
+    int32_t latitude;  // grados × 10^7, positivo al norte (ver gnss_coord_degrees)
+    int32_t longitude; // grados × 10^7, positivo al este
     float altitude;
 
     uint8_t hour;
@@ -20,8 +28,180 @@ typedef struct
 
     uint8_t fix_status;
     uint8_t satellites_used;
+    float hdop; // dilución horizontal de la precisión (GGA)
 
 } GNSSData_t;
 
-bool parse_gnss_buffer(const uint8_t* buffer, uint16_t length, GNSSData_t* gnss_data);
+// Satélites en vista que se registran (de todos los sistemas) y satélites usados en la solución
+#define GNSS_MAX_SATELLITES 48
+#define GNSS_MAX_USED 32
+
+// Factor de escala de las coordenadas de GNSSData_t (resolución de ~1 cm)
+#define GNSS_COORD_SCALE 10000000
+
+/**
+ * @brief Sistema de navegación de un satélite. Los valores coinciden con el identificador de
+ * sistema de la sentencia GSA (NMEA 4.11).
+ */
+typedef enum
+{
+    GNSS_SYSTEM_UNKNOWN,
+    GNSS_SYSTEM_GPS,     // emisor GP
+    GNSS_SYSTEM_GLONASS, // emisor GL
+    GNSS_SYSTEM_GALILEO, // emisor GA
+    GNSS_SYSTEM_BEIDOU,  // emisor GB
+    GNSS_SYSTEM_QZSS,    // emisor GQ
+    GNSS_SYSTEM_COUNT
+} gnss_system_t;
+
+typedef struct
+{
+    uint8_t system; // gnss_system_t
+    uint8_t prn;
+} gnss_prn_t;
+
+typedef struct
+{
+    uint8_t system;   // gnss_system_t
+    uint8_t prn;
+    int8_t elevation; // grados
+    uint16_t azimuth; // grados respecto al norte verdadero
+    uint8_t snr;      // dB-Hz, la mejor de sus señales; 0 si no se sigue
+} gnss_satellite_t;
+
+/**
+ * @brief Datos GNSS que no forman parte de GNSSData_t, tomados de GSA, GSV, VTG y ZDA.
+ *
+ * Cada sentencia actualiza solo sus campos. Las listas de satélites usados (GSA) y en vista
+ * (GSV) se rehacen en cada ciclo, que empieza con la RMC.
+ */
+typedef struct
+{
+    // GSA
+    uint8_t fix_mode; // 1 sin fijación, 2 2D, 3 3D
+    float pdop;
+    float hdop;
+    float vdop;
+    gnss_prn_t used[GNSS_MAX_USED];
+    uint8_t used_count;
+
+    // GSV
+    gnss_satellite_t satellites[GNSS_MAX_SATELLITES];
+    uint8_t satellite_count;
+
+    // VTG
+    float course;    // grados respecto al norte verdadero
+    float speed_kmh;
+
+    // ZDA (UTC, sin el ajuste de zona de GNSSData_t)
+    uint8_t utc_hour;
+    uint8_t utc_minute;
+    uint8_t utc_second;
+    uint8_t utc_day;
+    uint8_t utc_month;
+    uint16_t utc_year; // cuatro cifras
+} GNSSExtData_t;
+
+/**
+ * @brief Contadores de un tipo de sentencia NMEA.
+ *
+ * Una sentencia es rechazada si su suma de verificación falta o no coincide, o si tiene
+ * caracteres no imprimibles; es truncada si empieza otra antes del fin de línea o si excede
+ * NMEA_MAX_SENTENCE o NMEA_MAX_FIELDS. Solo las aceptadas se procesan.
+ */
+typedef struct
+{
+    char id[6]; // emisor y tipo (por ejemplo "GNRMC"); vacío si se cortó antes del tipo
+    uint32_t accepted;
+    uint32_t rejected;
+    uint32_t truncated;
+} nmea_stats_t;
+
+/**
+ * @brief Estado del analizador NMEA incremental.
+ *
+ * Los bytes se consumen de a uno, tal como llegan de la UART: una sentencia puede repartirse
+ * entre varias lecturas sin perderse. El cuerpo de la sentencia en curso se guarda una sola vez
+ * en `sentence` y cada campo se describe por su desplazamiento, sin copias ni terminadores.
+ */
+typedef struct
+{
+    char sentence[NMEA_MAX_SENTENCE];     // cuerpo de la sentencia en curso, sin '$'
+    uint8_t length;                       // bytes de `sentence`
+    uint8_t field_start[NMEA_MAX_FIELDS]; // desplazamiento de cada campo en `sentence`
+    uint8_t field_count;
+    uint8_t state;                        // nmea_state_t, ver api_gnss.c
+    uint8_t checksum;                     // XOR del cuerpo recibido hasta ahora
+    uint8_t expected;                     // suma de verificación recibida tras '*'
+    uint8_t checksum_digits;              // dígitos hexadecimales recibidos tras '*'
+    uint32_t code;                        // emisor y tipo empaquetados, 0 si no son válidos
+    uint8_t received;                     // sentencias del ciclo en curso ya recibidas (bits)
+    uint8_t cycle_seen;                   // GSA y GSV (por sistema) ya recibidas en el ciclo
+    GNSSData_t data;                      // datos del ciclo en curso
+    GNSSExtData_t extended;               // datos de GSA, GSV, VTG y ZDA
+    nmea_stats_t stats[NMEA_STATS_TYPES]; // la entrada 0 es la de las sentencias sin tipo
+    uint8_t stats_count;
+} gnss_parser_t;
+
+/**
+ * @brief Prepara el analizador para esperar el comienzo de una sentencia.
+ */
+void gnss_parser_init(gnss_parser_t* parser);
+
+/**
+ * @brief Consume bytes recibidos del GNSS.
+ *
+ * Cada sentencia se procesa en cuanto termina, sin volver a recorrerla, y solo si su suma de
+ * verificación es correcta. Un ciclo queda completo cuando se recibieron una RMC y una GGA.
+ *
+ * @param parser Analizador.
+ * @param bytes Bytes recibidos; no necesitan terminador ni empezar en una sentencia.
+ * @param length Cantidad de bytes.
+ * @param gnss_data Recibe los datos del último ciclo completo.
+ * @return true si al menos un ciclo se completó con estos bytes.
+ */
+bool gnss_parser_feed(gnss_parser_t* parser, const uint8_t* bytes, size_t length,
+                      GNSSData_t* gnss_data);
+
+/**
+ * @brief Datos de las sentencias GSA, GSV, VTG y ZDA recibidas hasta ahora.
+ *
+ * Se actualizan a medida que llegan las sentencias, así que pueden corresponder en parte al
+ * ciclo anterior al último informado por gnss_parser_feed.
+ *
+ * @param parser Analizador.
+ * @return Registro extendido, válido mientras exista el analizador.
+ */
+const GNSSExtData_t* gnss_parser_extended(const gnss_parser_t* parser);
+
+/**
+ * @brief Contadores de sentencias aceptadas, rechazadas y truncadas por tipo.
+ *
+ * Los contadores se acumulan desde gnss_parser_init.
+ *
+ * @param parser Analizador.
+ * @param[out] count Cantidad de entradas.
+ * @return Entradas por tipo, en orden de aparición, empezando por la de las sentencias sin tipo.
+ */
+const nmea_stats_t* gnss_parser_stats(const gnss_parser_t* parser, uint8_t* count);
+
+/**
+ * @brief Convierte una coordenada de GNSSData_t a grados decimales.
+ *
+ * @param coord Coordenada en grados × 10^7.
+ * @return Grados decimales, en doble precisión para no perder resolución.
+ */
+double gnss_coord_degrees(int32_t coord);
+
+/**
+ * @brief Reduce una coordenada de GNSSData_t a menos decimales, redondeando al más cercano.
+ *
+ * El resultado se puede mostrar con numfmt_fixed usando los mismos decimales.
+ *
+ * @param coord Coordenada en grados × 10^7.
+ * @param decimals Decimales del resultado (0 a 7).
+ * @return Grados × 10^decimals.
+ */
+int32_t gnss_coord_scale(int32_t coord, uint8_t decimals);
+
 #endif // API_GNSS_H
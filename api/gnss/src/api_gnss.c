@@ -1,7 +1,39 @@
 #include "api_gnss.h"
 #include "logger.h"
-#include <stdlib.h>
-#include <string.h>
+
+/**
+ * Estados del analizador. Una sentencia es "$<cuerpo>[*hh]\r\n"; el cuerpo son campos
+ * separados por comas y el primero indica el emisor y el tipo (por ejemplo GNRMC).
+ */
+typedef enum
+{
+    NMEA_WAIT_START, // descartando bytes hasta el próximo '$'
+    NMEA_BODY,       // guardando el cuerpo
+    NMEA_CHECKSUM,   // después de '*', hasta el fin de línea
+} nmea_state_t;
+
+// Sentencias que forman un ciclo completo
+#define GNSS_RECEIVED_RMC (1u << 0)
+#define GNSS_RECEIVED_GGA (1u << 1)
+#define GNSS_RECEIVED_ALL (GNSS_RECEIVED_RMC | GNSS_RECEIVED_GGA)
+
+// Sentencias que rehacen sus listas la primera vez que llegan en un ciclo (`cycle_seen`)
+#define GNSS_SEEN_GSV(system) (1u << (system))
+#define GNSS_SEEN_GSA (1u << 7)
+
+// Letras del emisor y el tipo que se empaquetan en `gnss_parser_t::code`, 5 bits cada una
+#define NMEA_ID_LENGTH 5
+// Tabla de despacho de 2^NMEA_DISPATCH_BITS entradas, al menos el doble de las sentencias
+#define NMEA_DISPATCH_BITS 5
+
+/**
+ * Campo de la sentencia en curso: apunta dentro de `gnss_parser_t::sentence`, sin terminador.
+ */
+typedef struct
+{
+    const char* text;
+    uint8_t length;
+} nmea_field_t;
 
 /**
  * @brief Ajusta la hora UTC a UTC-5 y realiza los ajustes necesarios en la fecha.
@@ -59,225 +91,781 @@ static void adjust_to_utc_minus_5(uint8_t* hour, uint8_t* day, uint8_t* month, u
 }
 
 /**
- * @brief Convierte una coordenada NMEA en grados decimales.
+ * @brief Obtiene un campo de la sentencia en curso.
+ *
+ * @param parser Analizador con una sentencia completa.
+ * @param index Número de campo; el 0 es el emisor y tipo.
+ * @return El campo, vacío si la sentencia tiene menos campos.
+ */
+static nmea_field_t nmea_field(const gnss_parser_t* parser, uint8_t index)
+{
+    if (index >= parser->field_count)
+    {
+        return (nmea_field_t){.text = parser->sentence, .length = 0};
+    }
+
+    // Cada campo termina en la coma que abre el siguiente, o al final del cuerpo
+    const uint8_t start = parser->field_start[index];
+    const uint8_t end =
+        index + 1 < parser->field_count ? parser->field_start[index + 1] - 1 : parser->length;
+    return (nmea_field_t){.text = &parser->sentence[start], .length = end - start};
+}
+
+/**
+ * @brief Compara un campo con una cadena terminada en nulo.
+ */
+static bool nmea_field_equals(nmea_field_t field, const char* text)
+{
+    for (uint8_t i = 0; i < field.length; i++)
+    {
+        if (text[i] != field.text[i])
+        {
+            return false;
+        }
+    }
+    return text[field.length] == '\0';
+}
+
+/**
+ * @brief Lee un número decimal de un campo, escalado por 10^decimals.
  *
- * Esta función toma una cadena de caracteres que representa una coordenada en formato NMEA
- * y la convierte a un valor de grados decimales. La dirección (N, S, E, W) se utiliza para
- * determinar si el valor resultante debe ser positivo o negativo.
+ * Los decimales que sobran se truncan y los que faltan se completan con ceros, de modo que
+ * "12.3" con 2 decimales da 1230.
  *
- * @param value Cadena de caracteres que contiene la coordenada en formato NMEA.
- * @param direction Carácter que indica la dirección de la coordenada ('N' para norte, 'S' para sur,
- *                  'E' para este, 'W' para oeste).
- * @return El valor de la coordenada en grados decimales.
+ * @param field Campo con dígitos, un signo '-' opcional y un punto opcional.
+ * @param decimals Decimales del resultado.
+ * @param[out] value Valor escalado.
+ * @return false si el campo está vacío o tiene otros caracteres.
  */
-static float convert_nmea_to_decimal_degrees(const char* value, char direction)
+static bool nmea_field_decimal(nmea_field_t field, uint8_t decimals, int32_t* value)
 {
-    // Para longitud, los primeros 3 dígitos son grados (074)
-    // Para latitud, los primeros 2 dígitos son grados (04)
-    int deg_length = (direction == 'E' || direction == 'W') ? 3 : 2;
+    int32_t result = 0;
+    bool negative = false;
+    bool point = false;
+    bool digits = false;
+    uint8_t fraction = 0;
+
+    for (uint8_t i = 0; i < field.length; i++)
+    {
+        const char c = field.text[i];
+
+        if (c == '-' && i == 0)
+        {
+            negative = true;
+        }
+        else if (c == '.' && !point)
+        {
+            point = true;
+        }
+        else if (c >= '0' && c <= '9')
+        {
+            digits = true;
+            if (point && fraction == decimals)
+            {
+                continue;
+            }
+            result = result * 10 + (c - '0');
+            fraction += point;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (!digits)
+    {
+        return false;
+    }
 
-    char deg_str[4] = {0};
-    strncpy(deg_str, value, deg_length);
+    for (; fraction < decimals; fraction++)
+    {
+        result *= 10;
+    }
+    *value = negative ? -result : result;
+    return true;
+}
 
-    float degrees = atof(deg_str);
-    float minutes = atof(value + deg_length);
-    float decimal = degrees + minutes / 60.0f;
+/**
+ * @brief Lee dos dígitos consecutivos de un campo.
+ */
+static uint8_t nmea_two_digits(nmea_field_t field, uint8_t offset)
+{
+    return (field.text[offset] - '0') * 10 + (field.text[offset + 1] - '0');
+}
 
-    return (direction == 'S' || direction == 'W') ? -decimal : decimal;
+/**
+ * @brief Indica si los primeros `count` caracteres de un campo son dígitos.
+ */
+static bool nmea_has_digits(nmea_field_t field, uint8_t count)
+{
+    if (field.length < count)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (field.text[i] < '0' || field.text[i] > '9')
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
- * @brief Parsea una sentencia RMC (Recommended Minimum Specific GNSS Data) y extrae los datos GNSS.
+ * @brief Convierte una coordenada NMEA en grados × 10^7.
  *
- * Esta función toma una sentencia RMC en formato NMEA y extrae la hora, latitud, longitud y fecha,
- * almacenando estos valores en una estructura GNSSData_t.
+ * La coordenada llega como grados y minutos juntos ("ddmm.mmmmm" para la latitud,
+ * "dddmm.mmmmm" para la longitud). Se lee como un entero de minutos escalado por 10^5, así que
+ * los grados son siempre lo que queda por encima de las dos cifras de minutos, sin importar
+ * cuántas cifras tengan. Los minutos se pasan a grados con aritmética entera, sin pasar por
+ * punto flotante. La dirección (N, S, E, W) determina el signo.
  *
- * @param[in] sentence La sentencia RMC en formato NMEA a ser parseada.
- * @param[out] data Estructura GNSSData_t donde se almacenarán los datos extraídos.
- * @return true si el parseo fue exitoso, false en caso contrario.
- *
- * @note La función ajusta la hora a UTC-5.
+ * @param value Campo con la coordenada.
+ * @param direction Campo con la dirección.
+ * @param[out] coord Grados × 10^7.
+ * @return false si alguno de los campos está vacío o no es válido.
+ */
+static bool nmea_coordinate(nmea_field_t value, nmea_field_t direction, int32_t* coord)
+{
+    int32_t ddmm; // grados * 100 + minutos, escalado por 10^5
+
+    if (direction.length != 1 || !nmea_field_decimal(value, 5, &ddmm) || ddmm < 0)
+    {
+        return false;
+    }
+
+    const int32_t degrees = ddmm / 10000000;
+    const int32_t minutes_e5 = ddmm % 10000000;
+    // minutos / 60 en grados × 10^7, redondeado: 10^7 / (60 * 10^5) = 100 / 60
+    *coord = degrees * GNSS_COORD_SCALE + (minutes_e5 * 100 + 30) / 60;
+
+    if (direction.text[0] == 'S' || direction.text[0] == 'W')
+    {
+        *coord = -*coord;
+    }
+    return true;
+}
+
+/**
+ * @brief Procesa una sentencia RMC (Recommended Minimum Specific GNSS Data).
  *
- * @details
- * La función divide la sentencia RMC en tokens utilizando la coma (',') como delimitador.
  * Los campos de interés son:
  * - Campo 1: Hora (HHMMSS)
- * - Campo 3: Latitud (en formato NMEA)
- * - Campo 5: Longitud (en formato NMEA)
- * - Campo 8: Fecha (DDMMYY)
+ * - Campos 3 y 4: Latitud y dirección
+ * - Campos 5 y 6: Longitud y dirección
+ * - Campo 9: Fecha (DDMMYY)
+ *
+ * Una posición vacía (sin fijación) se informa como 0. La hora y la fecha se ajustan a UTC-5 y
+ * solo se actualizan cuando ambas vienen completas: los datos del analizador persisten entre
+ * ciclos, y ajustar de nuevo valores ya ajustados los correría otras 5 horas. La RMC es la
+ * primera sentencia de cada ciclo, así que también marca el comienzo de uno nuevo.
+ *
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor (no se usa).
+ */
+static void parse_rmc_sentence(gnss_parser_t* parser, gnss_system_t system)
+{
+    GNSSData_t* data = &parser->data;
+    const nmea_field_t time = nmea_field(parser, 1);
+    const nmea_field_t date = nmea_field(parser, 9);
+
+    if (!nmea_coordinate(nmea_field(parser, 3), nmea_field(parser, 4), &data->latitude))
+    {
+        data->latitude = 0;
+    }
+    if (!nmea_coordinate(nmea_field(parser, 5), nmea_field(parser, 6), &data->longitude))
+    {
+        data->longitude = 0;
+    }
+    if (nmea_has_digits(time, 6) && date.length == 6 && nmea_has_digits(date, 6))
+    {
+        data->hour = nmea_two_digits(time, 0);
+        data->minute = nmea_two_digits(time, 2);
+        data->day = nmea_two_digits(date, 0);
+        data->month = nmea_two_digits(date, 2);
+        data->year = nmea_two_digits(date, 4);
+        adjust_to_utc_minus_5(&data->hour, &data->day, &data->month, &data->year);
+    }
+    parser->received |= GNSS_RECEIVED_RMC;
+    parser->cycle_seen = 0;
+}
+
+/**
+ * @brief Procesa una sentencia GGA y extrae el estado de la fijación, los satélites usados,
+ * el HDOP y la altitud.
+ *
+ * Los campos de interés son el 6 (calidad de la fijación), el 7 (satélites), el 8 (HDOP) y el 9
+ * (altitud sobre el nivel del mar). Los campos vacíos conservan el valor anterior.
+ *
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor (no se usa).
+ */
+static void parse_gga_sentence(gnss_parser_t* parser, gnss_system_t system)
+{
+    GNSSData_t* data = &parser->data;
+    int32_t value;
+
+    if (nmea_field_decimal(nmea_field(parser, 6), 0, &value))
+    {
+        data->fix_status = value > 0 ? 1 : 0;
+    }
+    if (nmea_field_decimal(nmea_field(parser, 7), 0, &value))
+    {
+        data->satellites_used = value;
+    }
+    if (nmea_field_decimal(nmea_field(parser, 8), 2, &value))
+    {
+        data->hdop = value / 100.0f;
+    }
+    if (nmea_field_decimal(nmea_field(parser, 9), 2, &value))
+    {
+        data->altitude = value / 100.0f;
+    }
+    parser->received |= GNSS_RECEIVED_GGA;
+}
+
+/**
+ * @brief Lee un campo decimal con dos decimales como float; si está vacío no modifica `value`.
+ */
+static void nmea_field_float(nmea_field_t field, float* value)
+{
+    int32_t scaled;
+
+    if (nmea_field_decimal(field, 2, &scaled))
+    {
+        *value = scaled / 100.0f;
+    }
+}
+
+/**
+ * @brief Procesa una sentencia GSA (GNSS DOP and Active Satellites).
+ *
+ * Los campos de interés son el 2 (tipo de fijación), del 3 al 14 (PRN de los satélites usados),
+ * del 15 al 17 (PDOP, HDOP y VDOP) y el 18 (sistema, desde NMEA 4.11). El receptor envía una GSA
+ * por sistema; la primera del ciclo vacía la lista de satélites usados.
+ *
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor, si el campo 18 no lo indica.
+ */
+static void parse_gsa_sentence(gnss_parser_t* parser, gnss_system_t system)
+{
+    GNSSExtData_t* ext = &parser->extended;
+    int32_t value;
+
+    if (!(parser->cycle_seen & GNSS_SEEN_GSA))
+    {
+        parser->cycle_seen |= GNSS_SEEN_GSA;
+        ext->used_count = 0;
+    }
+    if (nmea_field_decimal(nmea_field(parser, 18), 0, &value) && value > 0 &&
+        value < GNSS_SYSTEM_COUNT)
+    {
+        system = value;
+    }
+
+    if (nmea_field_decimal(nmea_field(parser, 2), 0, &value))
+    {
+        ext->fix_mode = value;
+    }
+    for (uint8_t i = 3; i <= 14 && ext->used_count < GNSS_MAX_USED; i++)
+    {
+        if (nmea_field_decimal(nmea_field(parser, i), 0, &value))
+        {
+            ext->used[ext->used_count++] = (gnss_prn_t){.system = system, .prn = value};
+        }
+    }
+    nmea_field_float(nmea_field(parser, 15), &ext->pdop);
+    nmea_field_float(nmea_field(parser, 16), &ext->hdop);
+    nmea_field_float(nmea_field(parser, 17), &ext->vdop);
+}
+
+/**
+ * @brief Procesa una sentencia GSV (GNSS Satellites in View).
+ *
+ * Después de los campos 1 a 3 (mensajes, número de mensaje y satélites en vista) vienen hasta
+ * cuatro grupos de PRN, elevación, azimut y SNR, y opcionalmente el identificador de señal. Un
+ * satélite que aparece en varias señales se registra una vez, con la mejor SNR. La primera GSV
+ * de cada sistema en el ciclo quita de la lista los satélites anteriores de ese sistema.
  *
- * La latitud y longitud se convierten a grados decimales utilizando la función convert_nmea_to_decimal_degrees.
- * La hora se ajusta a UTC-5 utilizando la función adjust_to_utc_minus_5.
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor.
  */
-static bool parse_rmc_sentence(const char* sentence, GNSSData_t* data)
+static void parse_gsv_sentence(gnss_parser_t* parser, gnss_system_t system)
 {
-    char* token = strtok((char*)sentence, ",");
-    char* next_token;
-    int field = 0;
+    GNSSExtData_t* ext = &parser->extended;
 
-    while (token != NULL)
+    if (!(parser->cycle_seen & GNSS_SEEN_GSV(system)))
     {
-        switch (field)
+        parser->cycle_seen |= GNSS_SEEN_GSV(system);
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < ext->satellite_count; i++)
         {
-        case 1: // Time
-            if (strlen(token) >= 6)
-            {
-                data->hour = (token[0] - '0') * 10 + (token[1] - '0');
-                data->minute = (token[2] - '0') * 10 + (token[3] - '0');
-            }
-            break;
-        case 3: // Latitude
-            if (strlen(token) > 0)
-            {
-                next_token = strtok(NULL, ",");
-                if (next_token != NULL)
-                {
-                    data->latitude = convert_nmea_to_decimal_degrees(token, next_token[0]);
-                }
-                else
-                {
-                    data->latitude = 0.0f;
-                }
-            }
-            else
+            if (ext->satellites[i].system != system)
             {
-                data->latitude = 0.0f;
+                ext->satellites[kept++] = ext->satellites[i];
             }
-            field++;
-            break;
-        case 5: // Longitude
-            if (strlen(token) > 0)
-            {
-                next_token = strtok(NULL, ",");
-                if (next_token != NULL)
-                {
-                    data->longitude = convert_nmea_to_decimal_degrees(token, next_token[0]);
-                }
-                else
-                {
-                    data->longitude = 0.0f;
-                }
-            }
-            else
-            {
-                data->longitude = 0.0f;
-            }
-            field++;
-            break;
-        case 8: // Date (DDMMYY) - Ajustado a la posición correcta
-            if (strlen(token) == 6)
+        }
+        ext->satellite_count = kept;
+    }
+
+    for (uint8_t field = 4; field + 3 < parser->field_count; field += 4)
+    {
+        int32_t prn, elevation = 0, azimuth = 0, snr = 0;
+
+        if (!nmea_field_decimal(nmea_field(parser, field), 0, &prn))
+        {
+            continue;
+        }
+        nmea_field_decimal(nmea_field(parser, field + 1), 0, &elevation);
+        nmea_field_decimal(nmea_field(parser, field + 2), 0, &azimuth);
+        nmea_field_decimal(nmea_field(parser, field + 3), 0, &snr);
+
+        uint8_t i = 0;
+        while (i < ext->satellite_count &&
+               (ext->satellites[i].system != system || ext->satellites[i].prn != prn))
+        {
+            i++;
+        }
+        if (i == ext->satellite_count)
+        {
+            if (i == GNSS_MAX_SATELLITES)
             {
-                data->day = (token[0] - '0') * 10 + (token[1] - '0');
-                data->month = (token[2] - '0') * 10 + (token[3] - '0');
-                data->year = (token[4] - '0') * 10 + (token[5] - '0');
+                continue;
             }
-            break;
+            ext->satellites[ext->satellite_count++] =
+                (gnss_satellite_t){.system = system, .prn = prn};
         }
-        token = strtok(NULL, ",");
-        field++;
-    }
 
-    adjust_to_utc_minus_5(&data->hour, &data->day, &data->month, &data->year);
-    return true;
+        gnss_satellite_t* sat = &ext->satellites[i];
+        sat->elevation = elevation;
+        sat->azimuth = azimuth;
+        if (snr > sat->snr)
+        {
+            sat->snr = snr;
+        }
+    }
 }
 
 /**
- * @brief Parsea una sentencia GGA y extrae datos GNSS.
+ * @brief Procesa una sentencia VTG (Course Over Ground and Ground Speed).
  *
- * Esta función toma una sentencia GGA en formato NMEA y extrae información relevante
- * como el número de satélites utilizados, la altitud y el estado de la fijación.
+ * Los campos de interés son el 1 (rumbo respecto al norte verdadero) y el 7 (velocidad en km/h).
  *
- * @param[in] sentence Puntero a la cadena de caracteres que contiene la sentencia GGA.
- * @param[out] data Puntero a una estructura GNSSData_t donde se almacenarán los datos extraídos.
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor (no se usa).
+ */
+static void parse_vtg_sentence(gnss_parser_t* parser, gnss_system_t system)
+{
+    nmea_field_float(nmea_field(parser, 1), &parser->extended.course);
+    nmea_field_float(nmea_field(parser, 7), &parser->extended.speed_kmh);
+}
+
+/**
+ * @brief Procesa una sentencia ZDA (Time and Date).
  *
- * @return true si el análisis se realizó correctamente, false si hubo un error (por ejemplo, punteros nulos).
+ * Los campos de interés son el 1 (hora, HHMMSS), el 2 (día), el 3 (mes) y el 4 (año de cuatro
+ * cifras), todos en UTC.
  *
- * @note La función espera que la sentencia GGA esté separada por comas.
- * 
- * @warning La función modifica la cadena de entrada 'sentence' debido al uso de strtok.
+ * @param parser Analizador con la sentencia completa.
+ * @param system Sistema del emisor (no se usa).
  */
-static bool parse_gga_sentence(const char* sentence, GNSSData_t* data)
+static void parse_zda_sentence(gnss_parser_t* parser, gnss_system_t system)
 {
-    if (sentence == NULL || data == NULL)
+    GNSSExtData_t* ext = &parser->extended;
+    const nmea_field_t time = nmea_field(parser, 1);
+    int32_t day, month, year;
+
+    if (nmea_has_digits(time, 6))
     {
-        ESP_LOGE("GNSS", "Null pointer in parse_gga_sentence: sentence=%p, data=%p", sentence,
-                 data);
-        return false;
+        ext->utc_hour = nmea_two_digits(time, 0);
+        ext->utc_minute = nmea_two_digits(time, 2);
+        ext->utc_second = nmea_two_digits(time, 4);
+    }
+    if (nmea_field_decimal(nmea_field(parser, 2), 0, &day) &&
+        nmea_field_decimal(nmea_field(parser, 3), 0, &month) &&
+        nmea_field_decimal(nmea_field(parser, 4), 0, &year))
+    {
+        ext->utc_day = day;
+        ext->utc_month = month;
+        ext->utc_year = year;
+    }
+}
+
+typedef void (*nmea_handler_t)(gnss_parser_t* parser, gnss_system_t system);
+
+typedef struct
+{
+    const char* id; // emisor y tipo
+    gnss_system_t system;
+    nmea_handler_t handler;
+} nmea_sentence_t;
+
+/**
+ * Sentencias que se procesan. RMC y GGA se aceptan solo del emisor combinado (GN), como envía el
+ * UC6580; GSA y GSV también de cada sistema.
+ */
+static const nmea_sentence_t nmea_sentences[] = {
+    {"GNRMC", GNSS_SYSTEM_UNKNOWN, parse_rmc_sentence},
+    {"GNGGA", GNSS_SYSTEM_UNKNOWN, parse_gga_sentence},
+    {"GNVTG", GNSS_SYSTEM_UNKNOWN, parse_vtg_sentence},
+    {"GNZDA", GNSS_SYSTEM_UNKNOWN, parse_zda_sentence},
+    {"GNGSA", GNSS_SYSTEM_UNKNOWN, parse_gsa_sentence},
+    {"GPGSA", GNSS_SYSTEM_GPS, parse_gsa_sentence},
+    {"GLGSA", GNSS_SYSTEM_GLONASS, parse_gsa_sentence},
+    {"GAGSA", GNSS_SYSTEM_GALILEO, parse_gsa_sentence},
+    {"GBGSA", GNSS_SYSTEM_BEIDOU, parse_gsa_sentence},
+    {"GQGSA", GNSS_SYSTEM_QZSS, parse_gsa_sentence},
+    {"GPGSV", GNSS_SYSTEM_GPS, parse_gsv_sentence},
+    {"GLGSV", GNSS_SYSTEM_GLONASS, parse_gsv_sentence},
+    {"GAGSV", GNSS_SYSTEM_GALILEO, parse_gsv_sentence},
+    {"GBGSV", GNSS_SYSTEM_BEIDOU, parse_gsv_sentence},
+    {"GQGSV", GNSS_SYSTEM_QZSS, parse_gsv_sentence},
+};
+
+#define NMEA_SENTENCE_COUNT (sizeof(nmea_sentences) / sizeof(nmea_sentences[0]))
+
+/**
+ * Tabla de despacho indexada por un hash del código empaquetado, con sondeo lineal. Se arma una
+ * sola vez en gnss_parser_init; una entrada con código 0 está libre.
+ */
+typedef struct
+{
+    uint32_t code;
+    const nmea_sentence_t* sentence;
+} nmea_slot_t;
+
+static nmea_slot_t nmea_dispatch[1u << NMEA_DISPATCH_BITS];
+
+/**
+ * @brief Agrega una letra del emisor y el tipo al código empaquetado.
+ *
+ * @param code Código de las letras anteriores, o 0 si no es válido.
+ * @param position Posición de la letra en el primer campo.
+ * @param c Letra.
+ * @return El nuevo código, o 0 si el primer campo no es un emisor y tipo de NMEA_ID_LENGTH
+ *         letras mayúsculas.
+ */
+static uint32_t nmea_pack(uint32_t code, uint8_t position, char c)
+{
+    if ((position && !code) || position >= NMEA_ID_LENGTH || c < 'A' || c > 'Z')
+    {
+        return 0;
+    }
+    return code << 5 | (uint32_t)(c - 'A' + 1);
+}
+
+/**
+ * @brief Posición inicial de un código en la tabla de despacho (hash multiplicativo).
+ */
+static uint8_t nmea_hash(uint32_t code)
+{
+    return (code * 2654435761u) >> (32 - NMEA_DISPATCH_BITS);
+}
+
+/**
+ * @brief Arma la tabla de despacho a partir de `nmea_sentences`, si todavía no se armó.
+ */
+static void nmea_dispatch_init(void)
+{
+    static bool ready;
+    const uint8_t mask = (1u << NMEA_DISPATCH_BITS) - 1;
+
+    if (ready)
+    {
+        return;
     }
-    char* token = strtok((char*)sentence, ",");
-    int field = 0;
 
-    while (token != NULL)
+    for (uint8_t i = 0; i < NMEA_SENTENCE_COUNT; i++)
     {
-        switch (field)
+        uint32_t code = 0;
+        for (uint8_t c = 0; c < NMEA_ID_LENGTH; c++)
         {
-        case 7: // Satellites used
-            data->satellites_used = atoi(token);
-            break;
-        case 9: // Altitude
-            if (strlen(token) > 0)
-            {
-                data->altitude = atof(token);
-            }
-            break;
-        case 6: // Fix status
-            data->fix_status = (atoi(token) > 0) ? 1 : 0;
-            break;
+            code = nmea_pack(code, c, nmea_sentences[i].id[c]);
         }
-        token = strtok(NULL, ",");
-        field++;
+
+        uint8_t slot = nmea_hash(code);
+        while (nmea_dispatch[slot].code)
+        {
+            slot = (slot + 1) & mask;
+        }
+        nmea_dispatch[slot] = (nmea_slot_t){.code = code, .sentence = &nmea_sentences[i]};
     }
-    return true;
+    ready = true;
+}
+
+/**
+ * @brief Busca la sentencia que corresponde a un código empaquetado.
+ *
+ * @return La sentencia, o NULL si no se procesa.
+ */
+static const nmea_sentence_t* nmea_lookup(uint32_t code)
+{
+    const uint8_t mask = (1u << NMEA_DISPATCH_BITS) - 1;
+
+    if (!code)
+    {
+        return NULL;
+    }
+    for (uint8_t slot = nmea_hash(code); nmea_dispatch[slot].code; slot = (slot + 1) & mask)
+    {
+        if (nmea_dispatch[slot].code == code)
+        {
+            return nmea_dispatch[slot].sentence;
+        }
+    }
+    return NULL;
 }
 
 /**
- * @brief Parsea un buffer GNSS y extrae datos RMC y GGA.
+ * @brief Procesa la sentencia que acaba de terminar.
  *
- * Esta función toma un buffer que contiene datos GNSS en formato NMEA y extrae
- * la información de las sentencias RMC y GGA, almacenándola en una estructura
- * GNSSData_t proporcionada por el usuario.
+ * El emisor y el tipo ya llegan empaquetados en `code`, así que la sentencia se despacha con una
+ * búsqueda en la tabla, sin comparar cadenas.
  *
- * @param buffer Puntero al buffer que contiene los datos GNSS en formato NMEA.
- * @param length Longitud del buffer.
- * @param gnss_data Puntero a la estructura GNSSData_t donde se almacenarán los datos extraídos.
- * @return true si ambas sentencias RMC y GGA fueron parseadas correctamente, false en caso contrario.
+ * @return true si con ella se completó un ciclo RMC + GGA.
+ */
+static bool gnss_parser_sentence(gnss_parser_t* parser)
+{
+    const nmea_sentence_t* sentence = nmea_lookup(parser->code);
+
+    if (sentence)
+    {
+        sentence->handler(parser, sentence->system);
+    }
+
+    if (parser->received == GNSS_RECEIVED_ALL)
+    {
+        parser->received = 0;
+        return true;
+    }
+    return false;
+}
+
+void gnss_parser_init(gnss_parser_t* parser)
+{
+    nmea_dispatch_init();
+    *parser = (gnss_parser_t){.state = NMEA_WAIT_START, .stats_count = 1};
+}
+
+/**
+ * @brief Contadores del tipo de la sentencia en curso.
+ *
+ * El tipo se conoce si el primer campo ya terminó. Los tipos nuevos se agregan mientras haya
+ * lugar; después se cuentan en la entrada sin tipo.
  *
- * @note La función espera que las sentencias NMEA estén separadas por "\r\n".
- * @note Si el buffer o gnss_data son NULL, la función registrará un error y retornará false.
+ * @param parser Analizador.
+ * @param complete true si la sentencia llegó hasta el fin de línea.
  */
-bool parse_gnss_buffer(const uint8_t* buffer, uint16_t length, GNSSData_t* gnss_data)
+static nmea_stats_t* nmea_stats_for(gnss_parser_t* parser, bool complete)
 {
-    if (buffer == NULL || gnss_data == NULL)
+    if (!complete && parser->field_count < 2)
     {
-        ESP_LOGE("GNSS", "Null pointer in parse_gnss_buffer: buffer=%p, gnss_data=%p", buffer,
-                 gnss_data);
+        return &parser->stats[0];
+    }
+
+    const nmea_field_t type = nmea_field(parser, 0);
+    if (type.length == 0 || type.length >= sizeof(parser->stats[0].id))
+    {
+        return &parser->stats[0];
+    }
+
+    for (uint8_t i = 1; i < parser->stats_count; i++)
+    {
+        if (nmea_field_equals(type, parser->stats[i].id))
+        {
+            return &parser->stats[i];
+        }
+    }
+    if (parser->stats_count == NMEA_STATS_TYPES)
+    {
+        return &parser->stats[0];
+    }
+
+    nmea_stats_t* stats = &parser->stats[parser->stats_count++];
+    for (uint8_t i = 0; i < type.length; i++)
+    {
+        stats->id[i] = type.text[i];
+    }
+    stats->id[type.length] = '\0';
+    return stats;
+}
+
+/**
+ * @brief Valor de un dígito hexadecimal, o -1 si no lo es.
+ */
+static int8_t nmea_hex_digit(uint8_t c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Descarta la sentencia en curso y la cuenta como truncada.
+ */
+static void gnss_parser_truncate(gnss_parser_t* parser)
+{
+    nmea_stats_for(parser, false)->truncated++;
+    parser->state = NMEA_WAIT_START;
+}
+
+/**
+ * @brief Termina la sentencia en curso al llegar el fin de línea.
+ *
+ * @return true si la sentencia era válida y con ella se completó un ciclo RMC + GGA.
+ */
+static bool gnss_parser_end(gnss_parser_t* parser)
+{
+    nmea_stats_t* stats = nmea_stats_for(parser, true);
+
+    parser->state = NMEA_WAIT_START;
+    if (parser->checksum_digits != 2 || parser->checksum != parser->expected)
+    {
+        stats->rejected++;
         return false;
     }
-    char* line_start = (char*)buffer;
-    char* line_end;
-    bool rmc_parsed = false;
-    bool gga_parsed = false;
+    stats->accepted++;
+    return gnss_parser_sentence(parser);
+}
 
-    while ((line_end = strstr(line_start, "\r\n")) != NULL)
+/**
+ * @brief Consume un byte de la sentencia en curso.
+ *
+ * Un '$' siempre empieza una sentencia nueva, de modo que una sentencia cortada se descarta en
+ * cuanto llega la siguiente. La suma de verificación se acumula a medida que llega el cuerpo y
+ * se compara al llegar el fin de línea.
+ *
+ * @return true si el byte terminó una sentencia y con ella un ciclo RMC + GGA.
+ */
+static bool gnss_parser_byte(gnss_parser_t* parser, uint8_t byte)
+{
+    if (byte == '$')
     {
-        *line_end = '\0';
+        if (parser->state != NMEA_WAIT_START)
+        {
+            gnss_parser_truncate(parser);
+        }
+        parser->length = 0;
+        parser->field_start[0] = 0;
+        parser->field_count = 1;
+        parser->checksum = 0;
+        parser->checksum_digits = 0;
+        parser->code = 0;
+        parser->state = NMEA_BODY;
+        return false;
+    }
 
-        if (strncmp(line_start, "$GNRMC", 6) == 0)
+    switch (parser->state)
+    {
+    case NMEA_BODY:
+        if (byte == '*')
         {
-            rmc_parsed = parse_rmc_sentence(line_start, gnss_data);
+            parser->expected = 0;
+            parser->state = NMEA_CHECKSUM;
+            return false;
         }
-        else if (strncmp(line_start, "$GNGGA", 6) == 0)
+        if (byte == '\r' || byte == '\n')
         {
-            gga_parsed = parse_gga_sentence(line_start, gnss_data);
+            return gnss_parser_end(parser);
         }
+        if (byte < ' ' || byte > '~')
+        {
+            nmea_stats_for(parser, false)->rejected++;
+            parser->state = NMEA_WAIT_START;
+            return false;
+        }
+        if (parser->length == NMEA_MAX_SENTENCE)
+        {
+            gnss_parser_truncate(parser);
+            return false;
+        }
+        if (byte == ',')
+        {
+            if (parser->field_count == NMEA_MAX_FIELDS)
+            {
+                gnss_parser_truncate(parser);
+                return false;
+            }
+            parser->field_start[parser->field_count++] = parser->length + 1;
+        }
+        else if (parser->field_count == 1)
+        {
+            parser->code = nmea_pack(parser->code, parser->length, byte);
+        }
+        parser->checksum ^= byte;
+        parser->sentence[parser->length++] = byte;
+        return false;
 
-        if (rmc_parsed && gga_parsed)
+    case NMEA_CHECKSUM:
+        if (byte == '\r' || byte == '\n')
         {
-            return true;
+            return gnss_parser_end(parser);
         }
+        const int8_t digit = nmea_hex_digit(byte);
+        if (digit < 0 || parser->checksum_digits >= 2)
+        {
+            // Se marca como inválida y se espera el fin de línea para contarla
+            parser->checksum_digits = 3;
+            return false;
+        }
+        parser->expected = parser->expected << 4 | digit;
+        parser->checksum_digits++;
+        return false;
 
-        line_start = line_end + 2;
+    default:
+        return false;
     }
+}
 
-    return false;
+bool gnss_parser_feed(gnss_parser_t* parser, const uint8_t* bytes, size_t length,
+                      GNSSData_t* gnss_data)
+{
+    bool complete = false;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (gnss_parser_byte(parser, bytes[i]))
+        {
+            *gnss_data = parser->data;
+            complete = true;
+        }
+    }
+    return complete;
+}
+
+const GNSSExtData_t* gnss_parser_extended(const gnss_parser_t* parser)
+{
+    return &parser->extended;
+}
+
+const nmea_stats_t* gnss_parser_stats(const gnss_parser_t* parser, uint8_t* count)
+{
+    *count = parser->stats_count;
+    return parser->stats;
+}
+
+double gnss_coord_degrees(int32_t coord) { return coord / (double)GNSS_COORD_SCALE; }
+
+int32_t gnss_coord_scale(int32_t coord, uint8_t decimals)
+{
+    int32_t divisor = 1;
+
+    for (; decimals < 7; decimals++)
+    {
+        divisor *= 10;
+    }
+    // Redondeo al más cercano, alejándose de cero en la mitad
+    const int32_t half = divisor / 2;
+    return coord < 0 ? -((-coord + half) / divisor) : (coord + half) / divisor;
 }
@@ -172,6 +172,24 @@
 // #define ST7735_HEIGHT 80
 // #define ST7735_ROTATION (ST7735_MADCTL_MY | ST7735_MADCTL_MV | ST7735_MADCTL_BGR)
 
+/*
+ * Framebuffer RGB565 doble en RAM interna. Con 1, las primitivas de dibujo escriben en el búfer
+ * trasero y registran rectángulos sucios; st7735_swap_buffers los copia al búfer frontal y
+ * st7735_flush_front envía al panel solo esas regiones por DMA. Con 0, cada primitiva escribe
+ * directamente en el panel.
+ */
+#ifndef ST7735_USE_FRAMEBUFFER
+#define ST7735_USE_FRAMEBUFFER 1
+#endif
+#define ST7735_MAX_DIRTY_RECTS 16
+
+/* Líneas de la memoria del controlador (132x162) a lo largo del eje de desplazamiento */
+#define ST7735_SCROLL_LINES 162
+
+/* Tiempos de la hoja de datos para entrar y salir del modo de reposo */
+#define ST7735_SLPOUT_DELAY_MS 5    // tras SLPOUT, antes del siguiente comando
+#define ST7735_SLEEP_SETTLE_MS 120  // entre un SLPIN y un SLPOUT, en cualquier orden
+
 /****************************/
 
 #define ST7735_NOP 0x00
@@ -195,8 +213,12 @@
 #define ST7735_RAMRD 0x2E
 
 #define ST7735_PTLAR 0x30
+#define ST7735_VSCRDEF 0x33
+#define ST7735_VSCSAD 0x37
 #define ST7735_COLMOD 0x3A
 #define ST7735_MADCTL 0x36
+#define ST7735_IDMOFF 0x38
+#define ST7735_IDMON 0x39
 
 #define ST7735_FRMCTR1 0xB1
 #define ST7735_FRMCTR2 0xB2
@@ -254,6 +276,79 @@ typedef enum
     GAMMA_18 = 0x08
 } GammaDef;
 
+/**
+ * @brief Contadores de tráfico SPI del controlador ST7735.
+ *
+ * Se actualizan en el propio microcontrolador cada vez que se envía un comando o un bloque
+ * de datos, lo que permite medir el costo real de cada primitiva de dibujo. Con framebuffer las
+ * primitivas solo escriben en memoria; `pixels` y `rects` cuentan lo que dejaron pendiente de
+ * enviar, antes de que el volcado una los rectángulos.
+ */
+typedef struct
+{
+    uint32_t transactions; ///< Número de transacciones SPI emitidas.
+    uint32_t bytes;        ///< Bytes totales enviados por el bus.
+    uint32_t pixels;       ///< Píxeles marcados como sucios en el framebuffer.
+    uint32_t rects;        ///< Rectángulos sucios registrados en el framebuffer.
+} ST7735_Stats;
+
+/**
+ * @brief Imagen RGB565 comprimida con RLE (generada con tools/rgb565_rle.py).
+ *
+ * `data` es una secuencia de bloques de 16 bits. Si el bit 15 de la cabecera está en 1, los
+ * 15 bits bajos son la longitud de una racha y el siguiente valor es el color que se repite; si
+ * está en 0, la cabecera indica cuántos colores literales la siguen. Los colores se guardan en
+ * RGB565 normal y la pantalla se recorre fila por fila; las rachas pueden cruzar filas.
+ */
+typedef struct
+{
+    uint16_t width;
+    uint16_t height;
+    uint32_t length; ///< Cantidad de valores de 16 bits en `data`.
+    const uint16_t* data;
+} ST7735_RleImage;
+
+/**
+ * @brief Franja con desplazamiento por hardware (VSCRDEF/VSCSAD).
+ *
+ * El controlador desplaza líneas completas de su memoria. Con MADCTL_MV esas líneas son columnas
+ * de la pantalla, así que la franja ocupa columnas completas y el contenido avanza hacia la
+ * izquierda; sin MV ocupa filas completas y avanza hacia arriba. Cada st7735_scroll_strip_push
+ * escribe solo la línea nueva y mueve el puntero de inicio, sin redibujar el resto de la franja.
+ */
+typedef struct
+{
+    uint16_t start;  ///< Primera columna (o fila) de la franja en coordenadas de pantalla.
+    uint16_t length; ///< Columnas (o filas) que ocupa la franja.
+    uint16_t tfa;    ///< Líneas de memoria fijas antes del área de desplazamiento.
+    uint16_t head;   ///< Línea de la muestra más reciente, relativa a `tfa`.
+} ST7735_ScrollStrip;
+
+/**
+ * @brief Ventana de dirección precalculada para una región fija de la pantalla.
+ *
+ * Se arma en tiempo de compilación con ST7735_WINDOW: además del rectángulo en coordenadas de
+ * pantalla guarda los argumentos de CASET y RASET ya desplazados por ST7735_XSTART/YSTART, que
+ * se envían tal cual. Las primitivas que reciben una ventana no recortan ni recalculan nada.
+ */
+typedef struct
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+    uint8_t caset[4]; ///< Argumentos de CASET: columna inicial y final, byte alto primero.
+    uint8_t raset[4]; ///< Argumentos de RASET: fila inicial y final, byte alto primero.
+} ST7735_Window;
+
+/* Ventana de (x1, y1) a (x2, y2), inclusive; la región debe estar dentro de la pantalla */
+#define ST7735_WINDOW(x1, y1, x2, y2)                                                            \
+    {                                                                                            \
+        .x = (x1), .y = (y1), .w = (x2) - (x1) + 1, .h = (y2) - (y1) + 1,                        \
+        .caset = {0x00, (x1) + ST7735_XSTART, 0x00, (x2) + ST7735_XSTART},                       \
+        .raset = {0x00, (y1) + ST7735_YSTART, 0x00, (y2) + ST7735_YSTART},                       \
+    }
+
 typedef struct
 {
     uint16_t width;
@@ -265,6 +360,7 @@ typedef struct
     uint8_t dc_pin;
     uint8_t led_k_pin;
     uint8_t rst_pin;
+    ST7735_Stats stats;
 } ST7735_Config;
 
 // Funciones de inicialización y configuración
@@ -272,6 +368,11 @@ void st7735_init(ST7735_Config* config);
 void st7735_set_gamma(ST7735_Config* config, GammaDef gamma);
 void st7735_invert_colors(ST7735_Config* config, bool invert);
 
+// Funciones de consumo
+void st7735_idle_mode(ST7735_Config* config, bool idle);
+void st7735_sleep(ST7735_Config* config);
+void st7735_wake(ST7735_Config* config);
+
 // Funciones de dibujo
 void st7735_draw_pixel(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t color);
 void st7735_fill_rectangle(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
@@ -279,11 +380,36 @@ void st7735_fill_rectangle(ST7735_Config* config, uint16_t x, uint16_t y, uint16
 void st7735_fill_screen(ST7735_Config* config, uint16_t color);
 void st7735_draw_image(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                        const uint16_t* data);
+void st7735_draw_rle_image(ST7735_Config* config, uint16_t x, uint16_t y,
+                           const ST7735_RleImage* image);
+void st7735_draw_bitmap_mono(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w,
+                             uint16_t h, const uint16_t* bitmap, uint16_t color,
+                             uint16_t bgcolor);
+void st7735_fill_window(ST7735_Config* config, const ST7735_Window* window, uint16_t color);
 
 // Funciones de texto
 void st7735_write_char(ST7735_Config* config, uint16_t x, uint16_t y, char ch, FontDef font,
                        uint16_t color, uint16_t bgcolor);
 void st7735_write_string(ST7735_Config* config, uint16_t x, uint16_t y, const char* str,
                          FontDef font, uint16_t color, uint16_t bgcolor);
+void st7735_write_window_text(ST7735_Config* config, const ST7735_Window* window,
+                              uint8_t column, const char* str, FontDef font, uint16_t color,
+                              uint16_t bgcolor);
+
+// Funciones de desplazamiento por hardware
+bool st7735_scroll_strip_init(ST7735_Config* config, ST7735_ScrollStrip* strip, uint16_t start,
+                              uint16_t length, uint16_t bgcolor);
+void st7735_scroll_strip_push(ST7735_Config* config, ST7735_ScrollStrip* strip,
+                              const uint16_t* line);
+void st7735_scroll_strip_stop(ST7735_Config* config, const ST7735_ScrollStrip* strip);
+
+// Funciones de framebuffer
+bool st7735_swap_buffers(ST7735_Config* config);
+void st7735_flush_front(ST7735_Config* config);
+void st7735_flush(ST7735_Config* config);
+
+// Funciones de estadísticas
+ST7735_Stats st7735_get_stats(const ST7735_Config* config);
+void st7735_reset_stats(ST7735_Config* config);
 
 #endif // __ST7735_H__
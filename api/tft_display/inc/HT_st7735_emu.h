@@ -0,0 +1,35 @@
+/* vim: set ai et ts=4 sw=4: */
+#ifndef __HT_ST7735_EMU_H__
+#define __HT_ST7735_EMU_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Emulador del ST7735 conectado debajo de st7735_write_cmd/st7735_write_data. Decodifica
+ * CASET, RASET y RAMWR sobre la memoria de 132x162 del controlador, aplicando el MADCTL
+ * recibido (MV, MX, MY y BGR), cuenta los píxeles reescritos con el mismo valor (redibujado
+ * redundante) y vuelca la imagen visible por el log para reconstruirla en el PC con
+ * tools/st7735_emu_dump.py. En el PC se compila con tools/host.
+ * Solo para depuración: ocupa ~67 KB de RAM, por eso está desactivado por defecto.
+ */
+#ifndef ST7735_USE_EMULATOR
+#define ST7735_USE_EMULATOR 0
+#endif
+
+typedef struct
+{
+    uint32_t pixel_writes;     ///< Píxeles escritos con RAMWR.
+    uint32_t redundant_writes; ///< Píxeles escritos con el valor que ya tenían.
+    uint32_t offscreen_writes; ///< Píxeles escritos fuera del área visible.
+    uint8_t madctl;            ///< Último valor recibido de MADCTL, ya aplicado a la imagen.
+} ST7735_EmuStats;
+
+void st7735_emu_command(uint8_t cmd);
+void st7735_emu_data(const uint8_t* data, size_t len);
+const uint16_t* st7735_emu_get_image(void);
+ST7735_EmuStats st7735_emu_get_stats(void);
+void st7735_emu_reset_stats(void);
+void st7735_emu_dump(const char* name);
+
+#endif // __HT_ST7735_EMU_H__
@@ -0,0 +1,33 @@
+/* vim: set ai et ts=4 sw=4: */
+#ifndef __HT_ST7735_GLYPH_CACHE_H__
+#define __HT_ST7735_GLYPH_CACHE_H__
+
+#include "HT_st7735_fonts.h"
+#include <stdint.h>
+
+/*
+ * Caché de glifos ya expandidos a RGB565 (en orden de bytes del panel), indexada por
+ * (fuente, carácter, color, color de fondo) y con reemplazo LRU. La memoria es fija:
+ * ST7735_GLYPH_CACHE_SLOTS entradas de ST7735_GLYPH_CACHE_MAX_PIXELS píxeles cada una.
+ * Los glifos más grandes que una entrada (Font_16x26) se expanden siempre sin caché.
+ */
+#ifndef ST7735_USE_GLYPH_CACHE
+#define ST7735_USE_GLYPH_CACHE 1
+#endif
+#define ST7735_GLYPH_CACHE_SLOTS 32
+#define ST7735_GLYPH_CACHE_MAX_PIXELS (11 * 18)
+
+typedef struct
+{
+    uint32_t hits;      ///< Glifos servidos desde la caché.
+    uint32_t misses;    ///< Glifos que hubo que expandir y guardar.
+    uint32_t evictions; ///< Entradas reemplazadas por LRU.
+    uint32_t bypass;    ///< Glifos demasiado grandes para la caché.
+} ST7735_GlyphCacheStats;
+
+void st7735_glyph_expand(uint16_t* dst, uint16_t stride, char ch, FontDef font, uint16_t color,
+                         uint16_t bgcolor);
+const uint16_t* st7735_glyph_cache_get(char ch, FontDef font, uint16_t color, uint16_t bgcolor);
+ST7735_GlyphCacheStats st7735_glyph_cache_get_stats(void);
+
+#endif // __HT_ST7735_GLYPH_CACHE_H__
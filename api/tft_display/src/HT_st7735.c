@@ -1,6 +1,14 @@
 #include "HT_st7735.h"
+#include "HT_st7735_emu.h"
+#include "HT_st7735_glyph_cache.h"
+#include "config.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "logger.h"
 #include <string.h>
 
@@ -8,6 +16,87 @@ static const char* TFT_STT35 = "ST7735";
 
 #define DELAY 0x80
 
+/* Capacidad en píxeles del búfer de transmisión, limitada por el tamaño máximo de transferencia
+ * configurado en el bus SPI */
+#define ST7735_TX_BUF_PIXELS (TFT_MAX_TRANSFER_SIZE / sizeof(uint16_t))
+
+/* Nivel del pin DC de cada transacción. Lo aplica el callback pre_cb del bus SPI a partir del
+ * campo `user`, así que comandos y datos pueden enviarse seguidos sin tocar el GPIO */
+#define ST7735_DC_COMMAND ((void*)0)
+#define ST7735_DC_DATA ((void*)1)
+
+/* Las transferencias de hasta este tamaño (bytes) se envían por polling, sin interrupción ni
+ * cambio de contexto */
+#define ST7735_POLLING_THRESHOLD 32
+
+/* Transacciones que pueden estar en vuelo a la vez en el canal DMA (ping-pong) */
+#define ST7735_QUEUE_DEPTH 2
+
+/* Búferes en RAM interna (aptos para DMA) de la cola de transacciones */
+static DMA_ATTR uint16_t st7735_tx_buf[ST7735_QUEUE_DEPTH][ST7735_TX_BUF_PIXELS];
+
+/* Estado de la cola de transacciones SPI encoladas con spi_device_queue_trans. En modo
+ * framebuffer la usan la tarea de volcado y, para la franja de desplazamiento, la de dibujo, así
+ * que los búferes y el estado solo se tocan con st7735_queue_mutex tomado */
+static spi_transaction_t st7735_queue_trans[ST7735_QUEUE_DEPTH];
+static uint8_t st7735_queue_next;
+static uint8_t st7735_queue_inflight;
+static SemaphoreHandle_t st7735_queue_mutex;
+static StaticSemaphore_t st7735_queue_mutex_buf;
+
+/* Píxeles de una línea de texto completa con la fuente más alta (Font_16x26) */
+#define ST7735_GLYPH_BUF_PIXELS (ST7735_WIDTH * 26)
+
+/* Búfer donde la tarea de dibujo expande glifos y mapas de bits. Nunca se entrega a la cola, así
+ * que no compite con el DMA de la tarea de volcado */
+static DMA_ATTR uint16_t st7735_glyph_buf[ST7735_GLYPH_BUF_PIXELS];
+
+/* Protege config->stats, que actualizan la tarea de dibujo y la de volcado desde núcleos
+ * distintos */
+static portMUX_TYPE st7735_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Eje de desplazamiento por hardware: con MV las líneas de memoria son columnas de pantalla, y
+ * MY invierte su orden */
+#define ST7735_SCROLL_ALONG_X ((ST7735_ROTATION & ST7735_MADCTL_MV) != 0)
+#define ST7735_SCROLL_REVERSED ((ST7735_ROTATION & ST7735_MADCTL_MY) != 0)
+
+/* Estado del decodificador RLE, que puede detenerse a mitad de una racha */
+typedef struct
+{
+    const uint16_t* src;
+    const uint16_t* end;
+    uint16_t remaining; // píxeles que quedan del bloque actual
+    bool literal;       // el bloque actual es de colores literales
+    uint16_t value;     // color de la racha actual, en orden de bytes del panel
+} st7735_rle_decoder_t;
+
+#if ST7735_USE_FRAMEBUFFER
+/* Rectángulo de pantalla con coordenadas inclusivas */
+typedef struct
+{
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+} st7735_rect_t;
+
+/* Imágenes de la pantalla en orden de bytes del panel, fila por fila. Las primitivas dibujan en
+ * st7735_fb (búfer trasero) y el panel se alimenta desde st7735_fb_front (búfer frontal) */
+static DMA_ATTR uint16_t st7735_fb[ST7735_WIDTH * ST7735_HEIGHT];
+static DMA_ATTR uint16_t st7735_fb_front[ST7735_WIDTH * ST7735_HEIGHT];
+
+/* Regiones del búfer trasero modificadas desde el último st7735_swap_buffers */
+static st7735_rect_t st7735_dirty[ST7735_MAX_DIRTY_RECTS];
+static uint8_t st7735_dirty_count;
+
+/* Regiones del búfer frontal pendientes de enviar al panel */
+static st7735_rect_t st7735_pending[ST7735_MAX_DIRTY_RECTS];
+static uint8_t st7735_pending_count;
+#endif
+
+/* Momento del último SLPIN o SLPOUT, para respetar ST7735_SLEEP_SETTLE_MS */
+static int64_t st7735_sleep_changed_us;
+
 const uint8_t init_cmds1[] = {15,
                               ST7735_SWRESET,
                               DELAY,
@@ -112,21 +201,59 @@ static void st7735_reset(ST7735_Config* config)
     gpio_set_level(config->rst_pin, 1);
 }
 
+/**
+ * @brief Envía una transacción y espera a que termine.
+ *
+ * Las transferencias pequeñas (comandos y sus argumentos) usan spi_device_polling_transmit, que
+ * espera activamente y evita la interrupción y el cambio de contexto de spi_device_transmit.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param t Transacción a enviar, con `user` indicando el nivel de DC.
+ * @return ESP_OK si la transmisión fue exitosa.
+ */
+static esp_err_t st7735_transmit(ST7735_Config* config, spi_transaction_t* t)
+{
+    if (t->length <= ST7735_POLLING_THRESHOLD * 8)
+    {
+        return spi_device_polling_transmit(config->spi_dev, t);
+    }
+    return spi_device_transmit(config->spi_dev, t);
+}
+
+/**
+ * @brief Suma una transacción enviada a las estadísticas de tráfico SPI.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param bytes Bytes de la transacción.
+ */
+static void st7735_stats_add(ST7735_Config* config, size_t bytes)
+{
+    taskENTER_CRITICAL(&st7735_stats_lock);
+    config->stats.transactions++;
+    config->stats.bytes += bytes;
+    taskEXIT_CRITICAL(&st7735_stats_lock);
+}
+
 static void st7735_write_cmd(ST7735_Config* config, uint8_t cmd)
 {
-    gpio_set_level((gpio_num_t)config->dc_pin, 0);
     spi_transaction_t t = {
+        .flags = SPI_TRANS_USE_TXDATA,
         .length = 8,
-        .tx_buffer = &cmd,
+        .user = ST7735_DC_COMMAND,
+        .tx_data = {cmd},
     };
-    ESP_ERROR_CHECK(spi_device_transmit(config->spi_dev, &t));
+    ESP_ERROR_CHECK(st7735_transmit(config, &t));
+    st7735_stats_add(config, 1);
+#if ST7735_USE_EMULATOR
+    st7735_emu_command(cmd);
+#endif
 }
 /**
  * @brief Escribe datos en la pantalla ST7735.
  *
- * Esta función envía un búfer de datos a la pantalla ST7735 usando SPI.
- * Establece el pin de datos/comando para indicar la transmisión de datos y luego
- * realiza la transacción SPI.
+ * Esta función envía un búfer de datos a la pantalla ST7735 usando SPI. La transacción se marca
+ * como datos para que el callback previo del bus ponga el pin DC en alto; los bloques pequeños se
+ * envían por polling.
  *
  * @param config Puntero a la estructura de configuración del ST7735.
  *               No debe ser NULL.
@@ -146,19 +273,124 @@ static void st7735_write_data(ST7735_Config* config, uint8_t* buff, size_t buff_
         return;
     }
 
-    gpio_set_level(config->dc_pin, 1);
-
     spi_transaction_t t = {
         .length = buff_size * 8,
+        .user = ST7735_DC_DATA,
         .tx_buffer = buff,
     };
 
-    esp_err_t ret = spi_device_transmit(config->spi_dev, &t);
+    esp_err_t ret = st7735_transmit(config, &t);
     if (ret != ESP_OK)
     {
         ESP_LOGE(TFT_STT35, "SPI transmission failed: %s", esp_err_to_name(ret));
         return;
     }
+    st7735_stats_add(config, buff_size);
+#if ST7735_USE_EMULATOR
+    st7735_emu_data(buff, buff_size);
+#endif
+}
+
+/**
+ * @brief Toma la cola de transacciones y sus búferes para la tarea que llama.
+ *
+ * Debe envolver todo el tramo entre st7735_select y st7735_unselect que use la cola, para que
+ * la ventana de dirección y sus datos no se mezclen con los de otra tarea.
+ */
+static void st7735_queue_lock(void) { xSemaphoreTake(st7735_queue_mutex, portMAX_DELAY); }
+
+/**
+ * @brief Libera la cola de transacciones tomada con st7735_queue_lock.
+ */
+static void st7735_queue_unlock(void) { xSemaphoreGive(st7735_queue_mutex); }
+
+/**
+ * @brief Espera a que termine la transacción encolada más antigua.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+static void st7735_queue_wait_one(ST7735_Config* config)
+{
+    spi_transaction_t* done;
+    esp_err_t ret = spi_device_get_trans_result(config->spi_dev, &done, portMAX_DELAY);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TFT_STT35, "SPI queued transfer failed: %s", esp_err_to_name(ret));
+    }
+    st7735_queue_inflight--;
+}
+
+/**
+ * @brief Espera a que terminen todas las transacciones encoladas.
+ *
+ * Debe llamarse antes de volver a usar las funciones bloqueantes de escritura, ya que el
+ * controlador SPI no permite mezclar transacciones encoladas y síncronas en curso.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+static void st7735_queue_drain(ST7735_Config* config)
+{
+    while (st7735_queue_inflight)
+    {
+        st7735_queue_wait_one(config);
+    }
+}
+
+/**
+ * @brief Obtiene el búfer DMA libre para preparar el siguiente bloque de píxeles.
+ *
+ * Si los dos búferes están en vuelo, espera a que termine el más antiguo, que es justamente
+ * el que se devuelve. Así la CPU prepara un bloque mientras el anterior se transmite.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @return Búfer de ST7735_TX_BUF_PIXELS píxeles listo para escribirse.
+ */
+static uint16_t* st7735_queue_acquire_buffer(ST7735_Config* config)
+{
+    if (st7735_queue_inflight == ST7735_QUEUE_DEPTH)
+    {
+        st7735_queue_wait_one(config);
+    }
+    return st7735_tx_buf[st7735_queue_next];
+}
+
+/**
+ * @brief Encola un bloque de datos para su envío por DMA sin esperar a que termine.
+ *
+ * El búfer debe permanecer válido hasta que la transacción termine (ver
+ * st7735_queue_acquire_buffer y st7735_queue_drain).
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param buff Datos a enviar, en memoria apta para DMA.
+ * @param buff_size Tamaño de los datos en bytes (como máximo TFT_MAX_TRANSFER_SIZE).
+ */
+static void st7735_queue_data(ST7735_Config* config, const void* buff, size_t buff_size)
+{
+    if (st7735_queue_inflight == ST7735_QUEUE_DEPTH)
+    {
+        st7735_queue_wait_one(config);
+    }
+
+    spi_transaction_t* t = &st7735_queue_trans[st7735_queue_next];
+    *t = (spi_transaction_t){
+        .length = buff_size * 8,
+        .user = ST7735_DC_DATA,
+        .tx_buffer = buff,
+    };
+
+    esp_err_t ret = spi_device_queue_trans(config->spi_dev, t, portMAX_DELAY);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TFT_STT35, "SPI queue failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    st7735_queue_next = (st7735_queue_next + 1) % ST7735_QUEUE_DEPTH;
+    st7735_queue_inflight++;
+    st7735_stats_add(config, buff_size);
+#if ST7735_USE_EMULATOR
+    st7735_emu_data(buff, buff_size);
+#endif
 }
 
 /**
@@ -209,6 +441,38 @@ static void st7735_execute_cmd_list(ST7735_Config* config, const uint8_t* addr)
         }
     }
 }
+/**
+ * @brief Envía la secuencia CASET/RASET/RAMWR con argumentos ya calculados.
+ *
+ * La secuencia se envía por polling con el bus reservado y con DC controlado desde el callback
+ * previo del bus, sin cambios de contexto entre transferencias. Los argumentos se copian a la
+ * pila porque pueden venir de una ventana en flash, que el DMA no puede leer.
+ *
+ * @param config Puntero a la estructura de configuración del ST7735.
+ * @param caset Columna inicial y final, ya desplazadas por x_start.
+ * @param raset Fila inicial y final, ya desplazadas por y_start.
+ */
+static void st7735_send_window(ST7735_Config* config, const uint8_t caset[4],
+                               const uint8_t raset[4])
+{
+    uint8_t data[4];
+
+    // Reserva el bus para que las cinco transferencias por polling salgan una tras otra
+    spi_device_acquire_bus(config->spi_dev, portMAX_DELAY);
+
+    st7735_write_cmd(config, ST7735_CASET);
+    memcpy(data, caset, sizeof(data));
+    st7735_write_data(config, data, sizeof(data));
+
+    st7735_write_cmd(config, ST7735_RASET);
+    memcpy(data, raset, sizeof(data));
+    st7735_write_data(config, data, sizeof(data));
+
+    st7735_write_cmd(config, ST7735_RAMWR);
+
+    spi_device_release_bus(config->spi_dev);
+}
+
 /**
  * @brief Configura la ventana de dirección del controlador ST7735.
  *
@@ -226,27 +490,224 @@ static void st7735_execute_cmd_list(ST7735_Config* config, const uint8_t* addr)
 static void st7735_set_address_window(ST7735_Config* config, uint8_t x0, uint8_t y0, uint8_t x1,
                                       uint8_t y1)
 {
-    st7735_write_cmd(config, ST7735_CASET);
-    uint8_t data[] = {0x00, x0 + config->x_start, 0x00, x1 + config->x_start};
-    st7735_write_data(config, data, sizeof(data));
+    const uint8_t caset[] = {0x00, x0 + config->x_start, 0x00, x1 + config->x_start};
+    const uint8_t raset[] = {0x00, y0 + config->y_start, 0x00, y1 + config->y_start};
 
-    st7735_write_cmd(config, ST7735_RASET);
-    data[1] = y0 + config->y_start;
-    data[3] = y1 + config->y_start;
-    st7735_write_data(config, data, sizeof(data));
+    st7735_send_window(config, caset, raset);
+}
 
-    st7735_write_cmd(config, ST7735_RAMWR);
+/**
+ * @brief Convierte un color RGB565 al orden de bytes que espera el panel.
+ *
+ * El ST7735 recibe cada píxel con el byte alto primero, mientras que el ESP32 almacena los
+ * `uint16_t` en little-endian. Los búferes de píxeles se guardan ya intercambiados para poder
+ * enviarlos tal cual por SPI.
+ *
+ * @param color Color en formato RGB565.
+ * @return Color con los bytes intercambiados.
+ */
+static inline uint16_t st7735_swap_color(uint16_t color)
+{
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+/**
+ * @brief Dibuja un glifo RGB565 dentro de un búfer de píxeles.
+ *
+ * Con la caché de glifos activa, los glifos repetidos se copian fila por fila desde la caché en
+ * lugar de decodificar de nuevo los bits de la fuente.
+ *
+ * @param dst Posición del búfer donde comienza el glifo.
+ * @param stride Ancho en píxeles de una fila del búfer de destino.
+ * @param ch Carácter a dibujar.
+ * @param font Fuente del carácter.
+ * @param color Color del carácter en formato RGB565.
+ * @param bgcolor Color de fondo en formato RGB565.
+ */
+static void st7735_render_glyph(uint16_t* dst, uint16_t stride, char ch, FontDef font,
+                                uint16_t color, uint16_t bgcolor)
+{
+#if ST7735_USE_GLYPH_CACHE
+    const uint16_t* glyph = st7735_glyph_cache_get(ch, font, color, bgcolor);
+    if (glyph)
+    {
+        for (uint32_t i = 0; i < font.height; i++)
+        {
+            memcpy(dst + i * stride, glyph + i * font.width, font.width * sizeof(uint16_t));
+        }
+        return;
+    }
+#endif
+    st7735_glyph_expand(dst, stride, ch, font, color, bgcolor);
+}
+
+#if ST7735_USE_FRAMEBUFFER
+static uint32_t st7735_rect_area(const st7735_rect_t* r)
+{
+    return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static st7735_rect_t st7735_rect_union(const st7735_rect_t* a, const st7735_rect_t* b)
+{
+    return (st7735_rect_t){
+        .x0 = a->x0 < b->x0 ? a->x0 : b->x0,
+        .y0 = a->y0 < b->y0 ? a->y0 : b->y0,
+        .x1 = a->x1 > b->x1 ? a->x1 : b->x1,
+        .y1 = a->y1 > b->y1 ? a->y1 : b->y1,
+    };
+}
+
+/**
+ * @brief Indica si conviene enviar dos rectángulos sucios como uno solo.
+ *
+ * Se unen cuando el rectángulo envolvente no cubre más píxeles que los dos por separado, es
+ * decir, cuando se solapan o son contiguos. Así se ahorra una ventana de dirección sin
+ * reenviar píxeles limpios.
+ */
+static bool st7735_rect_should_merge(const st7735_rect_t* a, const st7735_rect_t* b)
+{
+    st7735_rect_t u = st7735_rect_union(a, b);
+    return st7735_rect_area(&u) <= st7735_rect_area(a) + st7735_rect_area(b);
+}
+
+/**
+ * @brief Registra una región modificada del framebuffer.
+ *
+ * Si la lista está llena, la región se une al rectángulo existente cuyo envolvente crece menos.
+ * Los píxeles y rectángulos registrados se suman a las estadísticas de dibujo.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x0 Coordenada X inicial (inclusiva).
+ * @param y0 Coordenada Y inicial (inclusiva).
+ * @param x1 Coordenada X final (inclusiva).
+ * @param y1 Coordenada Y final (inclusiva).
+ */
+static void st7735_mark_dirty(ST7735_Config* config, uint16_t x0, uint16_t y0, uint16_t x1,
+                              uint16_t y1)
+{
+    st7735_rect_t r = {.x0 = x0, .y0 = y0, .x1 = x1, .y1 = y1};
+
+    taskENTER_CRITICAL(&st7735_stats_lock);
+    config->stats.pixels += st7735_rect_area(&r);
+    config->stats.rects++;
+    taskEXIT_CRITICAL(&st7735_stats_lock);
+
+    for (uint8_t i = 0; i < st7735_dirty_count; i++)
+    {
+        if (st7735_rect_should_merge(&st7735_dirty[i], &r))
+        {
+            st7735_dirty[i] = st7735_rect_union(&st7735_dirty[i], &r);
+            return;
+        }
+    }
+
+    if (st7735_dirty_count < ST7735_MAX_DIRTY_RECTS)
+    {
+        st7735_dirty[st7735_dirty_count++] = r;
+        return;
+    }
+
+    uint8_t best = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint8_t i = 0; i < st7735_dirty_count; i++)
+    {
+        st7735_rect_t u = st7735_rect_union(&st7735_dirty[i], &r);
+        uint32_t growth = st7735_rect_area(&u) - st7735_rect_area(&st7735_dirty[i]);
+        if (growth < best_growth)
+        {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    st7735_dirty[best] = st7735_rect_union(&st7735_dirty[best], &r);
+}
+
+/**
+ * @brief Une los rectángulos sucios que al crecer han quedado solapados o contiguos.
+ */
+static void st7735_coalesce_dirty(void)
+{
+    bool merged = true;
+
+    while (merged)
+    {
+        merged = false;
+        for (uint8_t i = 0; i < st7735_dirty_count; i++)
+        {
+            for (uint8_t j = i + 1; j < st7735_dirty_count; j++)
+            {
+                if (st7735_rect_should_merge(&st7735_dirty[i], &st7735_dirty[j]))
+                {
+                    st7735_dirty[i] = st7735_rect_union(&st7735_dirty[i], &st7735_dirty[j]);
+                    st7735_dirty[j] = st7735_dirty[--st7735_dirty_count];
+                    merged = true;
+                    j = i;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copia un bloque de píxeles al framebuffer, recortándolo a los límites de la pantalla.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x Coordenada X de la esquina superior izquierda.
+ * @param y Coordenada Y de la esquina superior izquierda.
+ * @param w Ancho del bloque.
+ * @param h Alto del bloque.
+ * @param pixels Píxeles en orden de bytes del panel, fila por fila.
+ */
+static void st7735_fb_blit(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                           const uint16_t* pixels)
+{
+    if ((x >= config->width) || (y >= config->height) || !w || !h)
+        return;
+
+    uint16_t cw = (x + w > config->width) ? config->width - x : w;
+    uint16_t ch = (y + h > config->height) ? config->height - y : h;
+
+    for (uint16_t row = 0; row < ch; row++)
+    {
+        memcpy(&st7735_fb[(y + row) * ST7735_WIDTH + x], &pixels[row * w], cw * sizeof(uint16_t));
+    }
+    st7735_mark_dirty(config, x, y, x + cw - 1, y + ch - 1);
+}
+#endif
+
+/**
+ * @brief Envía un bloque de píxeles a una ventana de la pantalla en una sola transacción.
+ *
+ * En modo framebuffer el bloque se copia a memoria y se envía en el siguiente st7735_flush.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x Coordenada X de la esquina superior izquierda.
+ * @param y Coordenada Y de la esquina superior izquierda.
+ * @param w Ancho de la ventana.
+ * @param h Alto de la ventana.
+ * @param pixels Píxeles en orden de bytes del panel, fila por fila.
+ */
+static void st7735_write_window(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w,
+                                uint16_t h, const uint16_t* pixels)
+{
+#if ST7735_USE_FRAMEBUFFER
+    st7735_fb_blit(config, x, y, w, h, pixels);
+#else
+    st7735_set_address_window(config, x, y, x + w - 1, y + h - 1);
+    st7735_write_data(config, (uint8_t*)pixels, (size_t)w * h * sizeof(uint16_t));
+#endif
 }
 
 /**
  * @brief Inicializa la pantalla ST7735.
  *
  * Esta función configura e inicializa la pantalla ST7735. Realiza los siguientes pasos:
- * 1. Enciende el pin LED_K para iluminar la pantalla.
- * 2. Selecciona el dispositivo ST7735 para la comunicación.
- * 3. Realiza un reinicio de hardware del dispositivo.
- * 4. Ejecuta una serie de comandos de inicialización para configurar la pantalla.
- * 5. Deselecciona el dispositivo ST7735.
+ * 1. Selecciona el dispositivo ST7735 para la comunicación.
+ * 2. Realiza un reinicio de hardware del dispositivo.
+ * 3. Ejecuta una serie de comandos de inicialización para configurar la pantalla.
+ * 4. Deselecciona el dispositivo ST7735.
+ *
+ * La luz de fondo (LED_K) no se toca aquí: la controla quien maneja el brillo.
  *
  * @param config Puntero a la estructura de configuración del ST7735.
  *               No debe ser NULL.
@@ -255,8 +716,10 @@ void st7735_init(ST7735_Config* config)
 {
     ESP_LOGI(TFT_STT35, "Inicializando pantalla...");
 
-    // Enciende el pin LED_K para iluminar la pantalla
-    gpio_set_level(config->led_k_pin, 1);
+    if (!st7735_queue_mutex)
+    {
+        st7735_queue_mutex = xSemaphoreCreateMutexStatic(&st7735_queue_mutex_buf);
+    }
 
     // Selecciona el dispositivo ST7735 para la comunicación
     st7735_select(config);
@@ -278,6 +741,7 @@ void st7735_init(ST7735_Config* config)
 
     // Deselecciona el dispositivo ST7735
     st7735_unselect(config);
+    st7735_sleep_changed_us = esp_timer_get_time();
 
     ESP_LOGI(TFT_STT35, "Pantalla inicializada");
 }
@@ -300,11 +764,16 @@ void st7735_draw_pixel(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t c
     if ((x >= config->width) || (y >= config->height))
         return;
 
+#if ST7735_USE_FRAMEBUFFER
+    st7735_fb[y * ST7735_WIDTH + x] = st7735_swap_color(color);
+    st7735_mark_dirty(config, x, y, x, y);
+#else
     st7735_select(config);
     st7735_set_address_window(config, x, y, x + 1, y + 1);
     uint8_t data[] = {color >> 8, color & 0xFF};
     st7735_write_data(config, data, sizeof(data));
     st7735_unselect(config);
+#endif
 }
 
 /**
@@ -312,7 +781,7 @@ void st7735_draw_pixel(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t c
  *
  * Esta función escribe un carácter específico en la pantalla TFT ST7735 en las coordenadas (x, y)
  * utilizando una fuente y colores especificados. La función configura una ventana de dirección
- * en la pantalla y luego dibuja el carácter píxel por píxel.
+ * en la pantalla y envía el glifo completo, expandido a RGB565, en una sola transacción SPI.
  *
  * @param config Puntero a la configuración del ST7735.
  * @param x Coordenada X donde se dibujará el carácter.
@@ -325,26 +794,8 @@ void st7735_draw_pixel(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t c
 void st7735_write_char(ST7735_Config* config, uint16_t x, uint16_t y, char ch, FontDef font,
                        uint16_t color, uint16_t bgcolor)
 {
-    uint32_t i, b, j;
-    st7735_set_address_window(config, x, y, x + font.width - 1, y + font.height - 1);
-
-    for (i = 0; i < font.height; i++)
-    {
-        b = font.data[(ch - 32) * font.height + i];
-        for (j = 0; j < font.width; j++)
-        {
-            if ((b << j) & 0x8000)
-            {
-                uint8_t data[] = {color >> 8, color & 0xFF};
-                st7735_write_data(config, data, sizeof(data));
-            }
-            else
-            {
-                uint8_t data[] = {bgcolor >> 8, bgcolor & 0xFF};
-                st7735_write_data(config, data, sizeof(data));
-            }
-        }
-    }
+    st7735_render_glyph(st7735_glyph_buf, font.width, ch, font, color, bgcolor);
+    st7735_write_window(config, x, y, font.width, font.height, st7735_glyph_buf);
 }
 
 /**
@@ -355,6 +806,9 @@ void st7735_write_char(ST7735_Config* config, uint16_t x, uint16_t y, char ch, F
  * automáticamente mueve la posición de escritura a la siguiente línea. Si la cadena de texto excede
  * el alto de la pantalla, la función deja de escribir.
  *
+ * Los caracteres que quedan en una misma línea se expanden juntos en el búfer de transmisión y
+ * se envían con una única ventana de dirección y una única transacción SPI.
+ *
  * @param config Puntero a la configuración del ST7735.
  * @param x Coordenada x inicial para escribir la cadena.
  * @param y Coordenada y inicial para escribir la cadena.
@@ -366,6 +820,7 @@ void st7735_write_char(ST7735_Config* config, uint16_t x, uint16_t y, char ch, F
 void st7735_write_string(ST7735_Config* config, uint16_t x, uint16_t y, const char* str,
                          FontDef font, uint16_t color, uint16_t bgcolor)
 {
+    const uint16_t max_run = ST7735_GLYPH_BUF_PIXELS / (font.width * font.height);
 
     while (*str)
     {
@@ -384,51 +839,199 @@ void st7735_write_string(ST7735_Config* config, uint16_t x, uint16_t y, const ch
                 continue;
             }
         }
-        st7735_write_char(config, x, y, *str, font, color, bgcolor);
-        x += font.width;
-        str++;
+
+        // Caracteres consecutivos que caben en la línea actual y en el búfer de transmisión
+        uint16_t run = (config->width - 1 - x) / font.width;
+        if (run > max_run)
+        {
+            run = max_run;
+        }
+
+        uint16_t n = 0;
+        while (n < run && str[n])
+        {
+            n++;
+        }
+
+        const uint16_t stride = n * font.width;
+        for (uint16_t i = 0; i < n; i++)
+        {
+            st7735_render_glyph(&st7735_glyph_buf[i * font.width], stride, str[i], font, color,
+                                bgcolor);
+        }
+        st7735_write_window(config, x, y, stride, font.height, st7735_glyph_buf);
+
+        x += stride;
+        str += n;
     }
 }
 
 /**
- * @brief Rellena un rectángulo en la pantalla ST7735 con un color específico.
+ * @brief Escribe texto en una línea de texto precalculada, sin saltos de línea.
  *
- * Esta función dibuja un rectángulo de ancho y alto especificados en las coordenadas (x, y)
- * de la pantalla ST7735, utilizando el color proporcionado. La función se asegura de que
- * el rectángulo no exceda los límites de la pantalla mediante recortes (clipping).
+ * La ventana debe tener el alto de la fuente. El texto empieza en la columna de caracteres
+ * `column` y se corta en el borde derecho de la ventana; los caracteres se expanden juntos y
+ * se envían con una sola ventana de dirección, tomada de la precalculada.
  *
  * @param config Puntero a la configuración del ST7735.
- * @param x Coordenada X del punto superior izquierdo del rectángulo.
- * @param y Coordenada Y del punto superior izquierdo del rectángulo.
- * @param w Ancho del rectángulo.
- * @param h Alto del rectángulo.
- * @param color Color con el que se rellenará el rectángulo.
+ * @param window Línea de texto armada con ST7735_WINDOW.
+ * @param column Columna de caracteres, dentro de la ventana, donde empieza el texto.
+ * @param str Texto a escribir.
+ * @param font Fuente del texto.
+ * @param color Color del texto.
+ * @param bgcolor Color de fondo del texto.
  */
-void st7735_fill_rectangle(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
-                           uint16_t color)
+void st7735_write_window_text(ST7735_Config* config, const ST7735_Window* window,
+                              uint8_t column, const char* str, FontDef font, uint16_t color,
+                              uint16_t bgcolor)
 {
-    // clipping
-    if ((x >= config->width) || (y >= config->height))
-        return;
-    if ((x + w - 1) >= config->width)
-        w = config->width - x;
-    if ((y + h - 1) >= config->height)
-        h = config->height - y;
+    const uint16_t columns = window->w / font.width;
+    const uint16_t max_run = ST7735_GLYPH_BUF_PIXELS / (font.width * font.height);
 
-    st7735_select(config);
-    st7735_set_address_window(config, x, y, x + w - 1, y + h - 1);
+    while (*str && column < columns)
+    {
+        uint16_t n = 0;
+        while (n < max_run && column + n < columns && str[n])
+        {
+            n++;
+        }
 
-    uint8_t data[] = {color >> 8, color & 0xFF};
-    gpio_set_level(config->dc_pin, 1);
-    for (uint16_t i = 0; i < h; i++)
+        const uint16_t stride = n * font.width;
+        for (uint16_t i = 0; i < n; i++)
+        {
+            st7735_render_glyph(&st7735_glyph_buf[i * font.width], stride, str[i], font, color,
+                                bgcolor);
+        }
+
+        const uint8_t offset = column * font.width;
+#if ST7735_USE_FRAMEBUFFER
+        st7735_fb_blit(config, window->x + offset, window->y, stride, font.height,
+                       st7735_glyph_buf);
+#else
+        // Solo cambian las columnas; las filas son las de la ventana
+        const uint8_t caset[] = {0x00, window->caset[1] + offset, 0x00,
+                                 window->caset[1] + offset + stride - 1};
+        st7735_send_window(config, caset, window->raset);
+        st7735_write_data(config, (uint8_t*)st7735_glyph_buf,
+                          (size_t)stride * font.height * sizeof(uint16_t));
+#endif
+
+        column += n;
+        str += n;
+    }
+}
+
+#if ST7735_USE_FRAMEBUFFER
+/**
+ * @brief Rellena un rectángulo del búfer trasero, ya recortado a la pantalla.
+ */
+static void st7735_fb_fill(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                           uint16_t color)
+{
+    const uint16_t fb_color = st7735_swap_color(color);
+    for (uint16_t row = y; row < y + h; row++)
     {
-        for (uint16_t j = 0; j < w; j++)
+        uint16_t* line = &st7735_fb[row * ST7735_WIDTH + x];
+        for (uint16_t col = 0; col < w; col++)
         {
-            st7735_write_data(config, data, sizeof(data));
+            line[col] = fb_color;
         }
     }
+    st7735_mark_dirty(config, x, y, x + w - 1, y + h - 1);
+}
+#else
+/**
+ * @brief Envía `w * h` píxeles de un mismo color a la ventana ya abierta, en bloques encolados.
+ */
+static void st7735_stream_color(ST7735_Config* config, uint16_t w, uint16_t h, uint16_t color)
+{
+    uint16_t lines = ST7735_TX_BUF_PIXELS / w;
+    if (lines > h)
+    {
+        lines = h;
+    }
+    const uint32_t chunk = (uint32_t)lines * w;
+
+    // El color es constante: todos los bloques comparten el mismo búfer, que solo se lee
+    uint16_t* buf = st7735_tx_buf[0];
+    const uint16_t swapped = st7735_swap_color(color);
+    for (uint32_t i = 0; i < chunk; i++)
+    {
+        buf[i] = swapped;
+    }
+
+    for (uint32_t remaining = (uint32_t)w * h; remaining > 0;)
+    {
+        uint32_t n = remaining < chunk ? remaining : chunk;
+        st7735_queue_data(config, buf, n * sizeof(uint16_t));
+        remaining -= n;
+    }
+    st7735_queue_drain(config);
+}
+#endif
+
+/**
+ * @brief Rellena un rectángulo en la pantalla ST7735 con un color específico.
+ *
+ * Esta función dibuja un rectángulo de ancho y alto especificados en las coordenadas (x, y)
+ * de la pantalla ST7735, utilizando el color proporcionado. La función se asegura de que
+ * el rectángulo no exceda los límites de la pantalla mediante recortes (clipping).
+ *
+ * El área se envía en bloques de líneas completas de hasta TFT_MAX_TRANSFER_SIZE bytes,
+ * encolados por DMA con spi_device_queue_trans para que el bus no quede inactivo entre bloques.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x Coordenada X del punto superior izquierdo del rectángulo.
+ * @param y Coordenada Y del punto superior izquierdo del rectángulo.
+ * @param w Ancho del rectángulo.
+ * @param h Alto del rectángulo.
+ * @param color Color con el que se rellenará el rectángulo.
+ */
+void st7735_fill_rectangle(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                           uint16_t color)
+{
+    // clipping
+    if ((x >= config->width) || (y >= config->height) || !w || !h)
+        return;
+    if ((x + w - 1) >= config->width)
+        w = config->width - x;
+    if ((y + h - 1) >= config->height)
+        h = config->height - y;
 
+#if ST7735_USE_FRAMEBUFFER
+    st7735_fb_fill(config, x, y, w, h, color);
+#else
+    st7735_queue_lock();
+    st7735_select(config);
+    st7735_set_address_window(config, x, y, x + w - 1, y + h - 1);
+    st7735_stream_color(config, w, h, color);
     st7735_unselect(config);
+    st7735_queue_unlock();
+#endif
+}
+
+/**
+ * @brief Rellena una ventana precalculada con un color.
+ *
+ * Equivale a st7735_fill_rectangle sobre el rectángulo de la ventana, pero sin recortes y
+ * enviando los argumentos de CASET/RASET guardados en ella.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param window Ventana armada con ST7735_WINDOW.
+ * @param color Color de relleno.
+ */
+void st7735_fill_window(ST7735_Config* config, const ST7735_Window* window, uint16_t color)
+{
+#if ST7735_USE_FRAMEBUFFER
+    st7735_fb_fill(config, window->x, window->y, window->w, window->h, color);
+#else
+    st7735_queue_lock();
+    st7735_select(config);
+    st7735_send_window(config, window->caset, window->raset);
+    st7735_stream_color(config, window->w, window->h, color);
+    st7735_unselect(config);
+    st7735_queue_unlock();
+#endif
 }
 
 /**
@@ -450,7 +1053,8 @@ void st7735_fill_screen(ST7735_Config* config, uint16_t color)
  *
  * Esta función dibuja una imagen en la pantalla ST7735 en las coordenadas
  * especificadas (x, y) con el ancho (w) y alto (h) dados. Los datos de la
- * imagen se proporcionan como un array de valores de color de 16 bits.
+ * imagen se proporcionan como un array de valores de color de 16 bits, que se envían tal cual
+ * (en el orden de bytes del panel) en bloques encolados por DMA.
  *
  * @param config Puntero a la estructura de configuración del ST7735.
  * @param x La coordenada x donde se dibujará la imagen.
@@ -466,17 +1070,146 @@ void st7735_fill_screen(ST7735_Config* config, uint16_t color)
 void st7735_draw_image(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                        const uint16_t* data)
 {
-    if ((x >= config->width) || (y >= config->height))
+    if ((x >= config->width) || (y >= config->height) || !w || !h)
         return;
     if ((x + w - 1) >= config->width)
         return;
     if ((y + h - 1) >= config->height)
         return;
 
+#if ST7735_USE_FRAMEBUFFER
+    st7735_fb_blit(config, x, y, w, h, data);
+#else
+
+    st7735_queue_lock();
     st7735_select(config);
     st7735_set_address_window(config, x, y, x + w - 1, y + h - 1);
-    st7735_write_data(config, (uint8_t*)data, sizeof(uint16_t) * w * h);
+
+    // Copia la imagen (normalmente en flash) a los búferes DMA por bloques de líneas; el
+    // siguiente bloque se prepara mientras el anterior está en el bus
+    const uint32_t chunk = (ST7735_TX_BUF_PIXELS / w) * w;
+    for (uint32_t remaining = (uint32_t)w * h; remaining > 0;)
+    {
+        uint32_t n = remaining < chunk ? remaining : chunk;
+        uint16_t* buf = st7735_queue_acquire_buffer(config);
+        memcpy(buf, data, n * sizeof(uint16_t));
+        st7735_queue_data(config, buf, n * sizeof(uint16_t));
+        data += n;
+        remaining -= n;
+    }
+    st7735_queue_drain(config);
+
+    st7735_unselect(config);
+    st7735_queue_unlock();
+#endif
+}
+
+/**
+ * @brief Publica en el búfer frontal lo dibujado en el búfer trasero.
+ *
+ * Une los rectángulos sucios solapados o contiguos, copia esas regiones del búfer trasero al
+ * frontal y las deja pendientes para st7735_flush_front. Solo copia memoria, por lo que es
+ * rápida; la tarea de dibujo puede seguir trabajando sobre el búfer trasero en cuanto termina.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @return true si hay regiones pendientes de enviar al panel.
+ *
+ * @note No debe llamarse mientras st7735_flush_front esté en curso en otra tarea.
+ */
+bool st7735_swap_buffers(ST7735_Config* config)
+{
+#if ST7735_USE_FRAMEBUFFER
+    (void)config;
+    st7735_coalesce_dirty();
+
+    for (uint8_t i = 0; i < st7735_dirty_count; i++)
+    {
+        const st7735_rect_t* r = &st7735_dirty[i];
+        const size_t row_bytes = (r->x1 - r->x0 + 1) * sizeof(uint16_t);
+
+        for (uint16_t y = r->y0; y <= r->y1; y++)
+        {
+            const uint32_t offset = y * ST7735_WIDTH + r->x0;
+            memcpy(&st7735_fb_front[offset], &st7735_fb[offset], row_bytes);
+        }
+        st7735_pending[i] = *r;
+    }
+    st7735_pending_count = st7735_dirty_count;
+    st7735_dirty_count = 0;
+
+    return st7735_pending_count > 0;
+#else
+    (void)config;
+    return false;
+#endif
+}
+
+/**
+ * @brief Envía al panel las regiones pendientes del búfer frontal.
+ *
+ * Transmite cada región con una sola ventana de dirección, en bloques encolados por DMA. Las
+ * regiones de ancho completo se envían directamente desde el búfer frontal; las demás se copian
+ * fila por fila a los búferes ping-pong mientras el bloque anterior está en el bus. Está pensada
+ * para ejecutarse en una tarea propia, en paralelo con el dibujo sobre el búfer trasero.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+void st7735_flush_front(ST7735_Config* config)
+{
+#if ST7735_USE_FRAMEBUFFER
+    st7735_queue_lock();
+    st7735_select(config);
+    for (uint8_t i = 0; i < st7735_pending_count; i++)
+    {
+        const st7735_rect_t* r = &st7735_pending[i];
+        const uint16_t w = r->x1 - r->x0 + 1;
+        const uint16_t lines = ST7735_TX_BUF_PIXELS / w;
+
+        st7735_set_address_window(config, r->x0, r->y0, r->x1, r->y1);
+
+        for (uint16_t y = r->y0; y <= r->y1; y += lines)
+        {
+            uint16_t n = (r->y1 - y + 1) < lines ? (r->y1 - y + 1) : lines;
+            const uint16_t* src = &st7735_fb_front[y * ST7735_WIDTH + r->x0];
+
+            if (w == ST7735_WIDTH)
+            {
+                st7735_queue_data(config, src, (size_t)n * w * sizeof(uint16_t));
+                continue;
+            }
+
+            uint16_t* buf = st7735_queue_acquire_buffer(config);
+            for (uint16_t row = 0; row < n; row++)
+            {
+                memcpy(&buf[row * w], &src[row * ST7735_WIDTH], w * sizeof(uint16_t));
+            }
+            st7735_queue_data(config, buf, (size_t)n * w * sizeof(uint16_t));
+        }
+        st7735_queue_drain(config);
+    }
     st7735_unselect(config);
+    st7735_queue_unlock();
+
+    st7735_pending_count = 0;
+#else
+    (void)config;
+#endif
+}
+
+/**
+ * @brief Envía al panel, de forma síncrona, todo lo dibujado desde la última actualización.
+ *
+ * Equivale a st7735_swap_buffers seguido de st7735_flush_front en la tarea que llama. Sin
+ * framebuffer (ST7735_USE_FRAMEBUFFER 0) no hace nada.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+void st7735_flush(ST7735_Config* config)
+{
+    if (st7735_swap_buffers(config))
+    {
+        st7735_flush_front(config);
+    }
 }
 
 /**
@@ -495,6 +1228,77 @@ void st7735_invert_colors(ST7735_Config* config, bool invert)
     st7735_unselect(config);
 }
 
+/**
+ * @brief Activa o desactiva el modo idle del ST7735.
+ *
+ * En modo idle el panel muestra solo 8 colores (el bit más alto de cada componente) y el
+ * controlador reduce su consumo. El contenido de la memoria no cambia, así que conviene para
+ * pantallas que no se están mirando.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param idle `true` para entrar en modo idle, `false` para volver a color completo.
+ */
+void st7735_idle_mode(ST7735_Config* config, bool idle)
+{
+    st7735_select(config);
+    st7735_write_cmd(config, idle ? ST7735_IDMON : ST7735_IDMOFF);
+    st7735_unselect(config);
+}
+
+/**
+ * @brief Espera lo que falte para que el último SLPIN o SLPOUT cumpla ST7735_SLEEP_SETTLE_MS.
+ */
+static void st7735_sleep_settle(void)
+{
+    const int64_t elapsed_ms = (esp_timer_get_time() - st7735_sleep_changed_us) / 1000;
+
+    if (elapsed_ms < ST7735_SLEEP_SETTLE_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(ST7735_SLEEP_SETTLE_MS - elapsed_ms) + 1);
+    }
+}
+
+/**
+ * @brief Apaga el panel y pone el controlador en reposo (SLPIN).
+ *
+ * En reposo se detienen el convertidor, el oscilador y el manejo del panel; la memoria y los
+ * registros se conservan, así que st7735_wake lo recupera sin repetir la inicialización. La
+ * luz de fondo debe apagarse antes, ya que el panel queda en blanco.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+void st7735_sleep(ST7735_Config* config)
+{
+    st7735_sleep_settle();
+
+    st7735_select(config);
+    st7735_write_cmd(config, ST7735_DISPOFF);
+    st7735_write_cmd(config, ST7735_SLPIN);
+    st7735_unselect(config);
+    st7735_sleep_changed_us = esp_timer_get_time();
+}
+
+/**
+ * @brief Saca el controlador del reposo y vuelve a encender el panel.
+ *
+ * Envía solo SLPOUT y DISPON: la configuración y la imagen siguen en el controlador, por lo que
+ * no hace falta el reinicio ni las listas init_cmds1..3 de st7735_init. La espera tras SLPOUT es
+ * más corta que un tick, así que se hace de forma activa.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+void st7735_wake(ST7735_Config* config)
+{
+    st7735_sleep_settle();
+
+    st7735_select(config);
+    st7735_write_cmd(config, ST7735_SLPOUT);
+    esp_rom_delay_us(ST7735_SLPOUT_DELAY_MS * 1000);
+    st7735_write_cmd(config, ST7735_DISPON);
+    st7735_unselect(config);
+    st7735_sleep_changed_us = esp_timer_get_time();
+}
+
 /**
  * @brief Configura la gamma del display ST7735.
  *
@@ -513,3 +1317,370 @@ void st7735_set_gamma(ST7735_Config* config, GammaDef gamma)
     st7735_write_cmd(config, ST7735_GAMSET);
     st7735_write_data(config, &data, 1);
 }
+
+/**
+ * @brief Convierte una posición de pantalla a lo largo del eje de desplazamiento en una línea de
+ * la memoria del controlador, o al revés (la conversión es su propia inversa).
+ */
+static uint16_t st7735_scroll_map(const ST7735_Config* config, uint16_t pos, bool to_memory)
+{
+    uint16_t offset = ST7735_SCROLL_ALONG_X ? config->x_start : config->y_start;
+
+    if (to_memory)
+    {
+        pos += offset;
+        return ST7735_SCROLL_REVERSED ? (ST7735_SCROLL_LINES - 1 - pos) : pos;
+    }
+    pos = ST7735_SCROLL_REVERSED ? (ST7735_SCROLL_LINES - 1 - pos) : pos;
+    return pos - offset;
+}
+
+/**
+ * @brief Envía un comando con argumentos de 16 bits (big endian), como VSCRDEF o VSCSAD.
+ */
+static void st7735_write_cmd16(ST7735_Config* config, uint8_t cmd, const uint16_t* args,
+                               uint8_t count)
+{
+    uint8_t data[6];
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        data[2 * i] = args[i] >> 8;
+        data[2 * i + 1] = args[i] & 0xFF;
+    }
+    st7735_write_cmd(config, cmd);
+    st7735_write_data(config, data, 2 * count);
+}
+
+/**
+ * @brief Abre la ventana de una línea de la franja (relativa a `tfa`) en la memoria del panel.
+ */
+static void st7735_scroll_window(ST7735_Config* config, const ST7735_ScrollStrip* strip,
+                                 uint16_t rel, uint16_t count)
+{
+    uint16_t first = st7735_scroll_map(config, strip->tfa + rel, false);
+    uint16_t last = st7735_scroll_map(config, strip->tfa + rel + count - 1, false);
+    uint16_t lo = first < last ? first : last;
+    uint16_t hi = first < last ? last : first;
+
+    if (ST7735_SCROLL_ALONG_X)
+        st7735_set_address_window(config, lo, 0, hi, config->height - 1);
+    else
+        st7735_set_address_window(config, 0, lo, config->width - 1, hi);
+}
+
+/**
+ * @brief Define una franja de desplazamiento por hardware y la borra.
+ *
+ * La franja abarca `length` columnas (o filas, si la rotación no usa MADCTL_MV) desde `start`,
+ * siempre de lado a lado de la pantalla, porque el controlador desplaza líneas completas. Se
+ * escribe directamente en el panel: en modo framebuffer no se debe dibujar en esa zona mientras
+ * la franja esté activa, y las llamadas deben hacerse sin un volcado en curso.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param strip Estado de la franja, que se inicializa.
+ * @param start Primera columna (o fila) de la franja.
+ * @param length Columnas (o filas) de la franja; al menos 2.
+ * @param bgcolor Color con el que se borra la franja.
+ * @return true si la franja cabe en la pantalla y quedó activa.
+ */
+bool st7735_scroll_strip_init(ST7735_Config* config, ST7735_ScrollStrip* strip, uint16_t start,
+                              uint16_t length, uint16_t bgcolor)
+{
+    uint16_t axis = ST7735_SCROLL_ALONG_X ? config->width : config->height;
+    uint16_t cross = ST7735_SCROLL_ALONG_X ? config->height : config->width;
+
+    if (length < 2 || start >= axis || (start + length) > axis)
+    {
+        ESP_LOGE(TFT_STT35, "Invalid scroll strip %u+%u", start, length);
+        return false;
+    }
+
+    uint16_t first = st7735_scroll_map(config, start, true);
+    uint16_t last = st7735_scroll_map(config, start + length - 1, true);
+
+    strip->start = start;
+    strip->length = length;
+    strip->tfa = first < last ? first : last;
+    // La muestra más reciente se muestra en la última posición de la franja
+    strip->head = last - strip->tfa;
+
+    uint16_t vscrdef[] = {strip->tfa, length, ST7735_SCROLL_LINES - strip->tfa - length};
+    uint16_t vscsad[] = {strip->tfa};
+
+    st7735_queue_lock();
+    st7735_select(config);
+    st7735_write_cmd16(config, ST7735_VSCRDEF, vscrdef, 3);
+    st7735_write_cmd16(config, ST7735_VSCSAD, vscsad, 1);
+
+    st7735_scroll_window(config, strip, 0, length);
+    uint16_t lines = ST7735_TX_BUF_PIXELS / cross;
+    uint16_t color = st7735_swap_color(bgcolor);
+    for (uint16_t i = 0; i < length; i += lines)
+    {
+        uint32_t n = (uint32_t)((length - i) < lines ? (length - i) : lines) * cross;
+        uint16_t* buf = st7735_queue_acquire_buffer(config);
+        for (uint32_t j = 0; j < n; j++)
+        {
+            buf[j] = color;
+        }
+        st7735_queue_data(config, buf, n * sizeof(uint16_t));
+    }
+    st7735_queue_drain(config);
+
+    st7735_unselect(config);
+    st7735_queue_unlock();
+    return true;
+}
+
+/**
+ * @brief Agrega una línea nueva al final de la franja y desplaza el resto una posición.
+ *
+ * Solo se envían la línea nueva y el puntero de inicio (VSCSAD), sin importar el tamaño de la
+ * franja. La línea más antigua desaparece por el otro extremo.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param strip Franja inicializada con st7735_scroll_strip_init.
+ * @param line Píxeles de la línea, de arriba a abajo (o de izquierda a derecha sin MADCTL_MV),
+ *             en orden de bytes del panel como en st7735_draw_image.
+ */
+void st7735_scroll_strip_push(ST7735_Config* config, ST7735_ScrollStrip* strip,
+                              const uint16_t* line)
+{
+    uint16_t cross = ST7735_SCROLL_ALONG_X ? config->height : config->width;
+    uint16_t newest = st7735_scroll_map(config, strip->start + strip->length - 1, true);
+    uint16_t newest_rel = newest - strip->tfa;
+
+    // La línea nueva reemplaza a la más antigua, que es la vecina de la más reciente en memoria
+    strip->head = ST7735_SCROLL_REVERSED ? (strip->head + strip->length - 1) % strip->length
+                                         : (strip->head + 1) % strip->length;
+    uint16_t vscsad[] = {strip->tfa +
+                         (strip->head + strip->length - newest_rel) % strip->length};
+
+    st7735_queue_lock();
+    st7735_select(config);
+
+    st7735_scroll_window(config, strip, strip->head, 1);
+    uint16_t* buf = st7735_queue_acquire_buffer(config);
+    memcpy(buf, line, cross * sizeof(uint16_t));
+    st7735_queue_data(config, buf, cross * sizeof(uint16_t));
+    st7735_queue_drain(config);
+
+    st7735_write_cmd16(config, ST7735_VSCSAD, vscsad, 1);
+
+    st7735_unselect(config);
+    st7735_queue_unlock();
+}
+
+/**
+ * @brief Sale del modo de desplazamiento y vuelve al modo normal (NORON).
+ *
+ * El contenido de la franja queda en el orden de la memoria; en modo framebuffer la zona se
+ * marca como sucia para que el próximo volcado la repinte, en modo directo hay que redibujarla.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param strip Franja activa.
+ */
+void st7735_scroll_strip_stop(ST7735_Config* config, const ST7735_ScrollStrip* strip)
+{
+    st7735_select(config);
+    st7735_write_cmd(config, ST7735_NORON);
+    st7735_unselect(config);
+
+#if ST7735_USE_FRAMEBUFFER
+    if (ST7735_SCROLL_ALONG_X)
+        st7735_mark_dirty(config, strip->start, 0, strip->start + strip->length - 1,
+                          config->height - 1);
+    else
+        st7735_mark_dirty(config, 0, strip->start, config->width - 1,
+                          strip->start + strip->length - 1);
+#else
+    (void)strip;
+#endif
+}
+
+/**
+ * @brief Decodifica los siguientes píxeles de una imagen RLE.
+ *
+ * Si los datos se terminan antes de tiempo, completa el resto con negro.
+ *
+ * @param dec Estado del decodificador.
+ * @param dst Destino de los píxeles, en orden de bytes del panel.
+ * @param count Cantidad de píxeles a decodificar.
+ */
+static void st7735_rle_decode(st7735_rle_decoder_t* dec, uint16_t* dst, uint32_t count)
+{
+    while (count)
+    {
+        if (!dec->remaining)
+        {
+            if (dec->src >= dec->end)
+            {
+                memset(dst, 0, count * sizeof(uint16_t));
+                return;
+            }
+            uint16_t header = *dec->src++;
+            dec->literal = !(header & 0x8000);
+            dec->remaining = header & 0x7FFF;
+            if (!dec->literal && dec->src < dec->end)
+            {
+                dec->value = st7735_swap_color(*dec->src++);
+            }
+            continue;
+        }
+
+        uint32_t n = dec->remaining < count ? dec->remaining : count;
+        if (dec->literal)
+        {
+            if (dec->src + n > dec->end)
+            {
+                n = dec->end - dec->src;
+                dec->remaining = n;
+                if (!n)
+                    continue;
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                dst[i] = st7735_swap_color(dec->src[i]);
+            }
+            dec->src += n;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                dst[i] = dec->value;
+            }
+        }
+        dst += n;
+        count -= n;
+        dec->remaining -= n;
+    }
+}
+
+/**
+ * @brief Dibuja una imagen comprimida con RLE en la pantalla ST7735.
+ *
+ * La imagen se descomprime por bloques de líneas completas en los búferes DMA ping-pong: mientras
+ * un bloque se transmite, la CPU descomprime el siguiente. En modo framebuffer se descomprime
+ * directamente sobre el framebuffer, fila por fila. Igual que st7735_draw_image, la imagen debe
+ * caber completa en la pantalla.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x Coordenada X de la esquina superior izquierda.
+ * @param y Coordenada Y de la esquina superior izquierda.
+ * @param image Imagen comprimida.
+ */
+void st7735_draw_rle_image(ST7735_Config* config, uint16_t x, uint16_t y,
+                           const ST7735_RleImage* image)
+{
+    const uint16_t w = image->width;
+    const uint16_t h = image->height;
+
+    if (!w || !h || (x >= config->width) || (y >= config->height))
+        return;
+    if ((x + w - 1) >= config->width)
+        return;
+    if ((y + h - 1) >= config->height)
+        return;
+
+    st7735_rle_decoder_t dec = {.src = image->data, .end = image->data + image->length};
+
+#if ST7735_USE_FRAMEBUFFER
+    for (uint16_t row = 0; row < h; row++)
+    {
+        st7735_rle_decode(&dec, &st7735_fb[(y + row) * ST7735_WIDTH + x], w);
+    }
+    st7735_mark_dirty(config, x, y, x + w - 1, y + h - 1);
+#else
+    st7735_queue_lock();
+    st7735_select(config);
+    st7735_set_address_window(config, x, y, x + w - 1, y + h - 1);
+
+    const uint16_t lines = ST7735_TX_BUF_PIXELS / w;
+    for (uint16_t row = 0; row < h; row += lines)
+    {
+        uint32_t n = (uint32_t)((h - row) < lines ? (h - row) : lines) * w;
+        uint16_t* buf = st7735_queue_acquire_buffer(config);
+        st7735_rle_decode(&dec, buf, n);
+        st7735_queue_data(config, buf, n * sizeof(uint16_t));
+    }
+    st7735_queue_drain(config);
+
+    st7735_unselect(config);
+    st7735_queue_unlock();
+#endif
+}
+
+/**
+ * @brief Dibuja un mapa de bits monocromo (1 bit por píxel) en la pantalla ST7735.
+ *
+ * Expande el mapa de bits a RGB565 con los colores indicados y lo envía con una sola ventana de
+ * dirección y una sola transacción SPI (o una sola copia al framebuffer), en lugar de dibujar
+ * píxel por píxel. La parte que queda fuera de la pantalla se recorta.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @param x Coordenada X de la esquina superior izquierda.
+ * @param y Coordenada Y de la esquina superior izquierda.
+ * @param w Ancho del mapa de bits (máximo 16).
+ * @param h Alto del mapa de bits.
+ * @param bitmap Una fila por elemento; el píxel de la izquierda es el bit (w - 1) y un bit en 1
+ *               se dibuja con `color`.
+ * @param color Color de los píxeles en 1.
+ * @param bgcolor Color de los píxeles en 0.
+ */
+void st7735_draw_bitmap_mono(ST7735_Config* config, uint16_t x, uint16_t y, uint16_t w,
+                             uint16_t h, const uint16_t* bitmap, uint16_t color, uint16_t bgcolor)
+{
+    if ((x >= config->width) || (y >= config->height) || !w || !h || w > 16)
+        return;
+
+    // clipping: solo se expanden las columnas y filas visibles
+    const uint16_t cw = (x + w > config->width) ? config->width - x : w;
+    const uint16_t ch = (y + h > config->height) ? config->height - y : h;
+    if ((uint32_t)cw * ch > ST7735_GLYPH_BUF_PIXELS)
+        return;
+
+    const uint16_t fg = st7735_swap_color(color);
+    const uint16_t bg = st7735_swap_color(bgcolor);
+    uint16_t* buf = st7735_glyph_buf;
+
+    for (uint16_t i = 0; i < ch; i++)
+    {
+        uint16_t row = bitmap[i];
+        for (uint16_t j = 0; j < cw; j++)
+        {
+            *buf++ = (row & (1 << (w - 1 - j))) ? fg : bg;
+        }
+    }
+
+    st7735_select(config);
+    st7735_write_window(config, x, y, cw, ch, st7735_glyph_buf);
+    st7735_unselect(config);
+}
+
+/**
+ * @brief Obtiene los contadores de tráfico SPI acumulados por el controlador.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ * @return Copia de los contadores de transacciones y bytes enviados.
+ */
+ST7735_Stats st7735_get_stats(const ST7735_Config* config)
+{
+    taskENTER_CRITICAL(&st7735_stats_lock);
+    ST7735_Stats stats = config->stats;
+    taskEXIT_CRITICAL(&st7735_stats_lock);
+    return stats;
+}
+
+/**
+ * @brief Reinicia los contadores de tráfico SPI del controlador.
+ *
+ * @param config Puntero a la configuración del ST7735.
+ */
+void st7735_reset_stats(ST7735_Config* config)
+{
+    taskENTER_CRITICAL(&st7735_stats_lock);
+    config->stats = (ST7735_Stats){0};
+    taskEXIT_CRITICAL(&st7735_stats_lock);
+}
@@ -0,0 +1,277 @@
+/* vim: set ai et ts=4 sw=4: */
+#include "HT_st7735_emu.h"
+#include "HT_st7735.h"
+#include "logger.h"
+#include <stdbool.h>
+
+#if ST7735_USE_EMULATOR
+
+static const char* TFT_EMU = "ST7735_EMU";
+
+/* Memoria del controlador: 132 columnas x 162 líneas, un píxel RGB565 por posición */
+#define EMU_GRAM_COLS 132
+#define EMU_GRAM_ROWS ST7735_SCROLL_LINES
+
+static uint16_t emu_gram[EMU_GRAM_ROWS * EMU_GRAM_COLS];
+
+/* Imagen visible armada desde la memoria por st7735_emu_get_image */
+static uint16_t emu_image[ST7735_WIDTH * ST7735_HEIGHT];
+static ST7735_EmuStats emu_stats;
+
+/* Estado del decodificador de comandos */
+static uint8_t emu_cmd;
+static uint8_t emu_args[4];
+static uint8_t emu_arg_count;
+
+/* Ventana de dirección en coordenadas del controlador (incluyen XSTART/YSTART) */
+static uint16_t emu_x0, emu_x1, emu_y0, emu_y1;
+
+/* Cursor de escritura de RAMWR y byte alto pendiente del píxel en curso */
+static uint16_t emu_col, emu_row;
+static int16_t emu_high_byte = -1;
+
+/**
+ * @brief Convierte una dirección de CASET/RASET en una posición de la memoria del controlador.
+ *
+ * Con MV las columnas de la ventana recorren líneas de memoria; MX y MY invierten después el
+ * orden de las columnas y de las líneas, igual que st7735_scroll_map en el driver.
+ *
+ * @param madctl Valor de MADCTL con el que se interpreta la dirección.
+ * @param x Columna de la ventana.
+ * @param y Fila de la ventana.
+ * @param col Columna de memoria resultante.
+ * @param row Línea de memoria resultante.
+ * @return false si la dirección cae fuera de la memoria.
+ */
+static bool emu_memory_cell(uint8_t madctl, uint16_t x, uint16_t y, uint16_t* col, uint16_t* row)
+{
+    *col = (madctl & ST7735_MADCTL_MV) ? y : x;
+    *row = (madctl & ST7735_MADCTL_MV) ? x : y;
+    if (*col >= EMU_GRAM_COLS || *row >= EMU_GRAM_ROWS)
+    {
+        return false;
+    }
+    if (madctl & ST7735_MADCTL_MX)
+    {
+        *col = EMU_GRAM_COLS - 1 - *col;
+    }
+    if (madctl & ST7735_MADCTL_MY)
+    {
+        *row = EMU_GRAM_ROWS - 1 - *row;
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si una posición de memoria se ve en la pantalla montada según ST7735_ROTATION.
+ */
+static bool emu_cell_visible(uint16_t col, uint16_t row)
+{
+    if (ST7735_ROTATION & ST7735_MADCTL_MX)
+    {
+        col = EMU_GRAM_COLS - 1 - col;
+    }
+    if (ST7735_ROTATION & ST7735_MADCTL_MY)
+    {
+        row = EMU_GRAM_ROWS - 1 - row;
+    }
+
+    const int32_t x = ((ST7735_ROTATION & ST7735_MADCTL_MV) ? row : col) - ST7735_XSTART;
+    const int32_t y = ((ST7735_ROTATION & ST7735_MADCTL_MV) ? col : row) - ST7735_YSTART;
+    return x >= 0 && y >= 0 && x < ST7735_WIDTH && y < ST7735_HEIGHT;
+}
+
+/**
+ * @brief Escribe un píxel en la posición del cursor y lo avanza dentro de la ventana.
+ *
+ * La posición se traduce a la memoria con el último MADCTL recibido. Igual que el controlador,
+ * al llegar al final de la ventana vuelve a su esquina superior.
+ *
+ * @param color Color del píxel en formato RGB565.
+ */
+static void emu_put_pixel(uint16_t color)
+{
+    uint16_t col, row;
+
+    emu_stats.pixel_writes++;
+    if (!emu_memory_cell(emu_stats.madctl, emu_col, emu_row, &col, &row))
+    {
+        emu_stats.offscreen_writes++;
+    }
+    else
+    {
+        uint16_t* px = &emu_gram[row * EMU_GRAM_COLS + col];
+        if (!emu_cell_visible(col, row))
+        {
+            emu_stats.offscreen_writes++;
+        }
+        else if (*px == color)
+        {
+            emu_stats.redundant_writes++;
+        }
+        *px = color;
+    }
+
+    if (++emu_col > emu_x1)
+    {
+        emu_col = emu_x0;
+        if (++emu_row > emu_y1)
+        {
+            emu_row = emu_y0;
+        }
+    }
+}
+
+/**
+ * @brief Procesa un byte de comando enviado al panel (DC en bajo).
+ *
+ * @param cmd Código del comando.
+ */
+void st7735_emu_command(uint8_t cmd)
+{
+    emu_cmd = cmd;
+    emu_arg_count = 0;
+    emu_high_byte = -1;
+
+    if (cmd == ST7735_RAMWR)
+    {
+        emu_col = emu_x0;
+        emu_row = emu_y0;
+    }
+}
+
+/**
+ * @brief Procesa un bloque de datos enviado al panel (DC en alto).
+ *
+ * @param data Bytes enviados.
+ * @param len Cantidad de bytes.
+ */
+void st7735_emu_data(const uint8_t* data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        switch (emu_cmd)
+        {
+        case ST7735_CASET:
+        case ST7735_RASET:
+            if (emu_arg_count < sizeof(emu_args))
+            {
+                emu_args[emu_arg_count++] = data[i];
+            }
+            if (emu_arg_count == sizeof(emu_args))
+            {
+                uint16_t start = (emu_args[0] << 8) | emu_args[1];
+                uint16_t end = (emu_args[2] << 8) | emu_args[3];
+                if (emu_cmd == ST7735_CASET)
+                {
+                    emu_x0 = start;
+                    emu_x1 = end;
+                }
+                else
+                {
+                    emu_y0 = start;
+                    emu_y1 = end;
+                }
+            }
+            break;
+        case ST7735_MADCTL:
+            emu_stats.madctl = data[i];
+            break;
+        case ST7735_RAMWR:
+            if (emu_high_byte < 0)
+            {
+                emu_high_byte = data[i];
+            }
+            else
+            {
+                emu_put_pixel((uint16_t)((emu_high_byte << 8) | data[i]));
+                emu_high_byte = -1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Devuelve la imagen emulada del panel (ST7735_WIDTH x ST7735_HEIGHT, RGB565).
+ *
+ * La imagen es la que vería quien mira el panel montado según ST7735_ROTATION: si el driver
+ * envió otro MADCTL, sale girada o espejada, y con el bit BGR cambiado, con rojo y azul
+ * intercambiados.
+ */
+const uint16_t* st7735_emu_get_image(void)
+{
+    const bool swap_rb = (emu_stats.madctl ^ ST7735_ROTATION) & ST7735_MADCTL_BGR;
+
+    for (uint16_t y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (uint16_t x = 0; x < ST7735_WIDTH; x++)
+        {
+            uint16_t col, row;
+            uint16_t c = 0;
+            if (emu_memory_cell(ST7735_ROTATION, x + ST7735_XSTART, y + ST7735_YSTART, &col, &row))
+            {
+                c = emu_gram[row * EMU_GRAM_COLS + col];
+            }
+            if (swap_rb)
+            {
+                c = (c & 0x07E0) | (c >> 11) | (c << 11);
+            }
+            emu_image[y * ST7735_WIDTH + x] = c;
+        }
+    }
+    return emu_image;
+}
+
+/**
+ * @brief Devuelve los contadores de escritura acumulados por el emulador.
+ */
+ST7735_EmuStats st7735_emu_get_stats(void) { return emu_stats; }
+
+/**
+ * @brief Reinicia los contadores de escritura, conservando el último MADCTL.
+ */
+void st7735_emu_reset_stats(void)
+{
+    uint8_t madctl = emu_stats.madctl;
+    emu_stats = (ST7735_EmuStats){.madctl = madctl};
+}
+
+/**
+ * @brief Vuelca la imagen emulada por el log.
+ *
+ * Formato de las líneas (una por fila, píxeles RGB565 en hexadecimal):
+ *   PPM <nombre> <ancho> <alto> <madctl>
+ *   R <fila> <píxeles>
+ *   END <nombre>
+ * tools/st7735_emu_dump.py las convierte en PPM/PNG y las compara con imágenes de referencia.
+ *
+ * @param name Nombre del cuadro, usado como nombre del archivo generado.
+ */
+void st7735_emu_dump(const char* name)
+{
+    static const char hex[] = "0123456789abcdef";
+    char line[ST7735_WIDTH * 4 + 1];
+    const uint16_t* image = st7735_emu_get_image();
+
+    ESP_LOGI(TFT_EMU, "PPM %s %d %d %02x", name, ST7735_WIDTH, ST7735_HEIGHT, emu_stats.madctl);
+    for (int y = 0; y < ST7735_HEIGHT; y++)
+    {
+        char* p = line;
+        for (int x = 0; x < ST7735_WIDTH; x++)
+        {
+            uint16_t c = image[y * ST7735_WIDTH + x];
+            *p++ = hex[(c >> 12) & 0xF];
+            *p++ = hex[(c >> 8) & 0xF];
+            *p++ = hex[(c >> 4) & 0xF];
+            *p++ = hex[c & 0xF];
+        }
+        *p = '\0';
+        ESP_LOGI(TFT_EMU, "R %d %s", y, line);
+    }
+    ESP_LOGI(TFT_EMU, "END %s", name);
+}
+
+#endif
@@ -0,0 +1,114 @@
+/* vim: set ai et ts=4 sw=4: */
+#include "HT_st7735_glyph_cache.h"
+#include "esp_attr.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct
+{
+    const uint16_t* font_data; // identifica la fuente
+    uint16_t color;
+    uint16_t bgcolor;
+    uint32_t last_use; // 0 = entrada libre
+    char ch;
+} glyph_cache_key_t;
+
+static glyph_cache_key_t glyph_keys[ST7735_GLYPH_CACHE_SLOTS];
+static DMA_ATTR uint16_t glyph_pixels[ST7735_GLYPH_CACHE_SLOTS][ST7735_GLYPH_CACHE_MAX_PIXELS];
+static uint32_t glyph_clock;
+static ST7735_GlyphCacheStats glyph_stats;
+
+/**
+ * @brief Expande un glifo de 1 bit por píxel a píxeles RGB565 dentro de un búfer.
+ *
+ * Los píxeles se escriben con el byte alto primero, que es el orden en que los espera el panel,
+ * para poder enviarlos o copiarlos al framebuffer sin más conversiones.
+ *
+ * @param dst Posición del búfer donde comienza el glifo.
+ * @param stride Ancho en píxeles de una fila del búfer de destino.
+ * @param ch Carácter a expandir.
+ * @param font Fuente del carácter.
+ * @param color Color del carácter en formato RGB565.
+ * @param bgcolor Color de fondo en formato RGB565.
+ */
+void st7735_glyph_expand(uint16_t* dst, uint16_t stride, char ch, FontDef font, uint16_t color,
+                         uint16_t bgcolor)
+{
+    const uint16_t* rows = &font.data[(ch - 32) * font.height];
+    const uint16_t fg = (uint16_t)((color >> 8) | (color << 8));
+    const uint16_t bg = (uint16_t)((bgcolor >> 8) | (bgcolor << 8));
+
+    for (uint32_t i = 0; i < font.height; i++)
+    {
+        uint32_t b = rows[i];
+        uint16_t* line = dst + i * stride;
+        for (uint32_t j = 0; j < font.width; j++)
+        {
+            line[j] = ((b << j) & 0x8000) ? fg : bg;
+        }
+    }
+}
+
+/**
+ * @brief Obtiene un glifo expandido desde la caché, expandiéndolo si no estaba.
+ *
+ * Si el glifo no está, ocupa una entrada libre o reemplaza la usada hace más tiempo.
+ *
+ * @param ch Carácter buscado.
+ * @param font Fuente del carácter.
+ * @param color Color del carácter en formato RGB565.
+ * @param bgcolor Color de fondo en formato RGB565.
+ * @return Píxeles del glifo (font.width x font.height, fila por fila) o NULL si el glifo es
+ *         demasiado grande para la caché.
+ */
+const uint16_t* st7735_glyph_cache_get(char ch, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+    if ((uint32_t)font.width * font.height > ST7735_GLYPH_CACHE_MAX_PIXELS)
+    {
+        glyph_stats.bypass++;
+        return NULL;
+    }
+
+    glyph_clock++;
+
+    uint8_t victim = 0;
+    for (uint8_t i = 0; i < ST7735_GLYPH_CACHE_SLOTS; i++)
+    {
+        glyph_cache_key_t* key = &glyph_keys[i];
+        if (key->last_use && key->ch == ch && key->font_data == font.data &&
+            key->color == color && key->bgcolor == bgcolor)
+        {
+            key->last_use = glyph_clock;
+            glyph_stats.hits++;
+            return glyph_pixels[i];
+        }
+        if (key->last_use < glyph_keys[victim].last_use)
+        {
+            victim = i;
+        }
+    }
+
+    if (glyph_keys[victim].last_use)
+    {
+        glyph_stats.evictions++;
+    }
+    glyph_stats.misses++;
+
+    glyph_keys[victim] = (glyph_cache_key_t){
+        .font_data = font.data,
+        .color = color,
+        .bgcolor = bgcolor,
+        .last_use = glyph_clock,
+        .ch = ch,
+    };
+    st7735_glyph_expand(glyph_pixels[victim], font.width, ch, font, color, bgcolor);
+
+    return glyph_pixels[victim];
+}
+
+/**
+ * @brief Obtiene los contadores de aciertos y fallos de la caché de glifos.
+ *
+ * @return Copia de los contadores acumulados desde el arranque.
+ */
+ST7735_GlyphCacheStats st7735_glyph_cache_get_stats(void) { return glyph_stats; }
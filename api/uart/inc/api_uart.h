@@ -23,6 +23,20 @@ esp_err_t uart_write_data(uart_t* uart, const uint8_t* request, size_t request_s
  */
 esp_err_t uart_read_data(uart_t* uart, uint8_t* response, size_t response_size, TickType_t timeout);
 
+/**
+ * @brief Lee los bytes que vayan llegando por UART, sin vaciar antes el buffer de recepción
+ *
+ * A diferencia de uart_read_data, no descarta lo que ya estaba recibido ni agrega un terminador,
+ * de modo que un flujo continuo (por ejemplo NMEA) se puede leer por partes sin perder bytes.
+ *
+ * @param uart Puntero a la estructura UART que contiene el puerto UART y otros ajustes
+ * @param buffer Puntero al buffer donde se almacenarán los datos leídos
+ * @param size Tamaño del buffer en bytes
+ * @param timeout Tiempo máximo para esperar datos en ticks
+ * @return La cantidad de bytes leídos (0 si venció el tiempo) o -1 si hubo un error
+ */
+int uart_read_stream(uart_t* uart, uint8_t* buffer, size_t size, TickType_t timeout);
+
 /**
  * @brief Devuelve el número de bytes disponibles en el buffer de recepción del UART
  * @param uart Puntero a la estructura UART que contiene el puerto UART y otros ajustes
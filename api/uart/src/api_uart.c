@@ -71,6 +71,31 @@ esp_err_t uart_read_data(uart_t* uart, uint8_t* response, size_t response_size,
     return ESP_OK;
 }
 
+/**
+ * @brief Lee de la UART los bytes que vayan llegando, sin vaciar antes el buffer de recepción.
+ *
+ * Espera hasta `timeout` a que llegue el primer byte y devuelve apenas se llene `buffer` o se
+ * cumpla el tiempo. Los bytes que no entran quedan en el buffer de la UART para la próxima
+ * lectura.
+ *
+ * @param uart Puntero a la estructura de la interfaz UART.
+ * @param buffer Puntero al buffer donde se almacenarán los datos leídos.
+ * @param size Tamaño del buffer.
+ * @param timeout Tiempo máximo para esperar a que se lean los datos, en ticks.
+ *
+ * @return La cantidad de bytes leídos, 0 si no llegó ninguno o -1 si ocurrió un error.
+ */
+int uart_read_stream(uart_t* uart, uint8_t* buffer, size_t size, TickType_t timeout)
+{
+    int len = uart_read_bytes(uart->uart_num, buffer, size, timeout);
+
+    if (len < 0)
+    {
+        ESP_LOGE(UART_TAG, "Error al leer datos de UART %d", uart->uart_num);
+    }
+    return len;
+}
+
 /**
  * @brief Devuelve la cantidad de bytes disponibles en la cola de UART.
  *
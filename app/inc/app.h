@@ -5,11 +5,19 @@
 #include "api_gnss.h"
 #include "api_uart.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "shared_data.h"
 #include "tft_spi_handler.h"
 
-#define GNSS_MAX_MESSAGE_SIZE 2000
+// Bytes que se leen de la UART del GNSS por vez (una línea NMEA tiene hasta 82)
+#define GNSS_READ_CHUNK_SIZE 128
 #define GNSS_TIMEOUT_MS 1000
+// Ciclos GNSS entre cada registro de los contadores de sentencias NMEA
+#define GNSS_STATS_EPOCHS 60
+
+// Núcleos de la tarea de dibujo y de la tarea que envía el framebuffer al panel
+#define TFT_RENDER_CORE 0
+#define TFT_FLUSH_CORE 1
 
 typedef struct
 {
@@ -27,6 +35,11 @@ typedef struct
 {
     tft_config_t tft_host;
     ST7735_Config tft_config;
+    SemaphoreHandle_t flush_request; // hay regiones nuevas en el búfer frontal
+    SemaphoreHandle_t flush_done;    // el búfer frontal ya se envió y puede reescribirse
+    QueueSetHandle_t events;         // colas GNSS y de suelo, tick de animación y botón
+    SemaphoreHandle_t tick;          // lo libera el planificador de animaciones (tft_animation)
+    SemaphoreHandle_t button;        // lo libera la interrupción del botón en cada flanco
 } TFTElements_t;
 
 extern QueueHandle_t xQueueGNSSData; // cola para los datos del GNSS
@@ -0,0 +1,79 @@
+/**
+ * @file number_formatter.h
+ * @brief Formateo de enteros y valores de punto fijo sin printf ni memoria dinámica.
+ *
+ * Los números se escriben directamente en un búfer del llamador, que siempre queda terminado
+ * en '\0' y se trunca si no alcanza. Los valores de punto fijo son enteros escalados: 215 con
+ * un decimal es "21.5" y 4637108 con seis decimales es "4.637108". Así la pantalla y los logs
+ * no dependen del printf de punto flotante de newlib, que es lento y usa mucha pila.
+ *
+ * Uso:
+ *   char text[16];
+ *   numfmt_t fmt;
+ *   numfmt_init(&fmt, text, sizeof(text));
+ *   numfmt_str(&fmt, "T: ");
+ *   numfmt_fixed(&fmt, numfmt_scale(21.5f, 1), 1, 0, ' ');
+ */
+
+#ifndef NUMBER_FORMATTER_H
+#define NUMBER_FORMATTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+    char* buf;   ///< Búfer de destino del llamador.
+    size_t size; ///< Tamaño del búfer, incluido el terminador.
+    size_t len;  ///< Caracteres escritos hasta ahora.
+} numfmt_t;
+
+/**
+ * @brief Prepara un formateador sobre el búfer indicado y lo deja vacío.
+ *
+ * @param fmt Formateador a inicializar.
+ * @param buf Búfer de destino.
+ * @param size Tamaño del búfer; debe ser al menos 1.
+ */
+void numfmt_init(numfmt_t* fmt, char* buf, size_t size);
+
+/**
+ * @brief Agrega una cadena de texto.
+ *
+ * @param fmt Formateador.
+ * @param str Cadena terminada en '\0'.
+ */
+void numfmt_str(numfmt_t* fmt, const char* str);
+
+/**
+ * @brief Agrega un entero en decimal.
+ *
+ * @param fmt Formateador.
+ * @param value Valor a escribir.
+ * @param width Ancho mínimo; los caracteres que falten se completan a la izquierda.
+ * @param pad Relleno: ' ' (antes del signo) o '0' (después del signo).
+ */
+void numfmt_int(numfmt_t* fmt, int32_t value, uint8_t width, char pad);
+
+/**
+ * @brief Agrega un valor de punto fijo con la cantidad de decimales indicada.
+ *
+ * @param fmt Formateador.
+ * @param value Valor escalado por 10^decimals.
+ * @param decimals Cantidad de decimales (0 a 9).
+ * @param width Ancho mínimo, incluidos el signo y el punto decimal.
+ * @param pad Relleno: ' ' (antes del signo) o '0' (después del signo).
+ */
+void numfmt_fixed(numfmt_t* fmt, int32_t value, uint8_t decimals, uint8_t width, char pad);
+
+/**
+ * @brief Convierte un valor en punto flotante a punto fijo, redondeando al más cercano.
+ *
+ * @param value Valor a convertir.
+ * @param decimals Cantidad de decimales (0 a 9).
+ * @return El valor multiplicado por 10^decimals, saturado a INT32_MIN o INT32_MAX si no cabe
+ *         (NaN da INT32_MIN).
+ */
+int32_t numfmt_scale(float value, uint8_t decimals);
+
+#endif /* NUMBER_FORMATTER_H */
@@ -0,0 +1,83 @@
+/**
+ * @file tft_animation.h
+ * @brief Planificador de animaciones de la pantalla TFT.
+ *
+ * Cada animación tiene su propio periodo y una función que dibuja un cuadro en su región
+ * (parpadeo de íconos, indicadores de espera, alertas). Un único temporizador de software de un
+ * disparo se programa para la próxima animación pendiente y libera el semáforo de tick que
+ * Task_TFTDisplay espera en su conjunto de colas; ahí se llama a tft_animation_run, que dibuja
+ * solo las animaciones vencidas. Un tope global de cuadros por segundo limita cuántas veces se
+ * despierta la tarea aunque haya muchas animaciones con periodos distintos.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef TFT_ANIMATION_H
+#define TFT_ANIMATION_H
+
+#include "HT_st7735.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Tope global de cuadros de animación por segundo
+#define TFT_ANIMATION_MAX_FPS 20
+
+// Animaciones que pueden estar activas al mismo tiempo
+#define TFT_ANIMATION_MAX 8
+
+typedef struct tft_animation tft_animation_t;
+
+/**
+ * @brief Dibuja un cuadro de la animación. `anim->frame` cuenta los cuadros desde que empezó.
+ *
+ * No debe iniciar ni detener animaciones.
+ */
+typedef void (*tft_animation_draw_t)(ST7735_Config* config, const tft_animation_t* anim);
+
+struct tft_animation
+{
+    tft_animation_draw_t draw; ///< Dibuja un cuadro; solo debe tocar la región animada.
+    const void* ctx;           ///< Datos propios de la animación (ícono, región, colores).
+    uint16_t period_ms;        ///< Tiempo entre cuadros.
+    uint32_t frame;            ///< Cuadros dibujados desde tft_animation_start.
+    TickType_t due;            ///< Momento del próximo cuadro.
+    bool running;
+};
+
+/**
+ * @brief Crea el temporizador del planificador.
+ *
+ * @param tick Semáforo binario que se libera cuando hay cuadros pendientes.
+ */
+void tft_animation_init(SemaphoreHandle_t tick);
+
+/**
+ * @brief Activa una animación. Su primer cuadro se dibuja en el próximo tick.
+ *
+ * No hace nada si ya estaba activa, de modo que puede llamarse cada vez que llega un dato.
+ *
+ * @param anim Animación; la memoria es del llamador y debe seguir existiendo mientras esté activa.
+ * @return false si ya hay TFT_ANIMATION_MAX animaciones activas.
+ */
+bool tft_animation_start(tft_animation_t* anim);
+
+/**
+ * @brief Detiene una animación. El llamador dibuja el estado final de la región.
+ *
+ * @param anim Animación activa o detenida.
+ */
+void tft_animation_stop(tft_animation_t* anim);
+
+/**
+ * @brief Dibuja las animaciones vencidas y programa el siguiente tick.
+ *
+ * Debe llamarse desde Task_TFTDisplay cada vez que se toma el semáforo de tick.
+ *
+ * @param config Configuración de la pantalla sobre la que se dibuja.
+ */
+void tft_animation_run(ST7735_Config* config);
+
+#endif /* TFT_ANIMATION_H */
@@ -0,0 +1,35 @@
+/**
+ * @file tft_benchmark.h
+ * @brief Medición del rendimiento del controlador de pantalla HT_st7735.
+ *
+ * Mide, para cada primitiva de dibujo y para un cuadro completo del tablero, los bytes enviados
+ * por SPI, el número de transacciones y el tiempo transcurrido, y los registra en el log.
+ * También se ejecuta en el PC, sobre un bus SPI simulado, con el programa tft_bench de
+ * tools/host.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef TFT_BENCHMARK_H
+#define TFT_BENCHMARK_H
+
+#include "app.h"
+
+// Define para ejecutar (1) o no (0) el benchmark de pantalla al iniciar la tarea del TFT
+#define TFT_BENCHMARK 0
+
+// Repeticiones de cada primitiva para promediar el tiempo
+#define TFT_BENCHMARK_ITERATIONS 10
+
+/**
+ * @brief Ejecuta el benchmark de la pantalla y registra los resultados.
+ *
+ * Debe llamarse desde la tarea del TFT después de st7735_init y antes de publicar el primer
+ * cuadro, ya que envía el framebuffer al panel de forma síncrona.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ */
+void tft_benchmark_run(TFTElements_t* tft_elements);
+
+#endif /* TFT_BENCHMARK_H */
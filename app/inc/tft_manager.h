@@ -22,8 +22,45 @@
 #define TFT_MANAGER_H
 
 #include "HT_st7735.h"
+#include "app.h"
 #include "tft_spi_handler.h"
 
 void Task_TFTDisplay(void* pvParameters);
 
+/**
+ * @brief Tarea que envía el búfer frontal del framebuffer a la pantalla TFT.
+ *
+ * Espera a que la tarea de dibujo publique un cuadro nuevo, lo transmite por DMA y avisa
+ * cuando el búfer frontal puede volver a escribirse.
+ *
+ * @param pvParameters Puntero a la estructura TFTElements_t compartida con Task_TFTDisplay.
+ */
+void Task_TFTFlush(void* pvParameters);
+
+/**
+ * @brief Dibuja un cuadro completo del tablero con los datos GNSS y de suelo indicados.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param gnss_data Datos GNSS a mostrar.
+ * @param soil_data Datos del sensor de suelo a mostrar.
+ */
+void tft_render_frame(TFTElements_t* tft_elements, GNSSData_t* gnss_data, SoilData_t* soil_data);
+
+/**
+ * @brief Marca todas las regiones de la pantalla como desactualizadas.
+ *
+ * Cada región recuerda lo último que dibujó y solo redibuja lo que cambió; después de borrar la
+ * pantalla hay que llamar a esta función para que el siguiente cuadro se dibuje completo.
+ */
+void tft_widgets_invalidate(void);
+
+/**
+ * @brief Comprueba que las regiones de una misma página no se superpongan.
+ *
+ * Cada par superpuesto se informa en el log.
+ *
+ * @return Cantidad de pares de regiones superpuestos; 0 si la distribución es correcta.
+ */
+int tft_layout_check(void);
+
 #endif /* TFT_MANAGER_H */
@@ -0,0 +1,86 @@
+/**
+ * @file tft_power.h
+ * @brief Modos de consumo de la pantalla TFT según la inactividad del usuario.
+ *
+ * La pantalla pasa por tres estados:
+ * - Activo: color completo y brillo TFT_BACKLIGHT_ACTIVE.
+ * - Reposo: tras TFT_POWER_IDLE_S sin tocar el botón, el panel entra en modo idle (8 colores)
+ *   y el brillo baja a TFT_BACKLIGHT_IDLE. Los datos se siguen mostrando.
+ * - Dormido: tras TFT_POWER_SLEEP_S sin tocar el botón, la luz se apaga y el controlador entra
+ *   en reposo (SLPIN). No se dibuja nada hasta despertar.
+ *
+ * Cualquier pulsación vuelve al estado activo. Al despertar se envían solo SLPOUT y DISPON,
+ * sin repetir la inicialización, y se registra cuánto tardó.
+ *
+ * Task_TFTDisplay usa tft_power_timeout como límite de espera en su conjunto de colas, de modo
+ * que los cambios de estado no requieren ningún temporizador ni sondeo. Las funciones que envían
+ * comandos deben llamarse sin un volcado en curso.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef TFT_POWER_H
+#define TFT_POWER_H
+
+#include "HT_st7735.h"
+#include "freertos/FreeRTOS.h"
+#include <stdint.h>
+
+// Segundos sin interacción para pasar a reposo y para dormir el panel (contados desde la
+// última pulsación; TFT_POWER_SLEEP_S debe ser mayor que TFT_POWER_IDLE_S)
+#define TFT_POWER_IDLE_S 60
+#define TFT_POWER_SLEEP_S 300
+
+// Brillo de la luz de fondo, en porcentaje
+#define TFT_BACKLIGHT_ACTIVE 100
+#define TFT_BACKLIGHT_IDLE 20
+
+typedef enum
+{
+    TFT_POWER_ACTIVE,
+    TFT_POWER_IDLE,
+    TFT_POWER_SLEEP
+} tft_power_state_t;
+
+/**
+ * @brief Empieza en estado activo, con el brillo completo. Debe llamarse tras st7735_init.
+ */
+void tft_power_init(void);
+
+/**
+ * @brief Ticks hasta el próximo cambio de estado por inactividad.
+ *
+ * @return 0 si el cambio ya venció, portMAX_DELAY si el panel ya está dormido.
+ */
+TickType_t tft_power_timeout(void);
+
+/**
+ * @brief Aplica el cambio de estado por inactividad, si ya venció.
+ *
+ * @param config Configuración de la pantalla.
+ * @return Estado resultante.
+ */
+tft_power_state_t tft_power_update(ST7735_Config* config);
+
+/**
+ * @brief Registra una interacción del usuario y vuelve al estado activo.
+ *
+ * @param config Configuración de la pantalla.
+ * @return Estado anterior a la interacción.
+ */
+tft_power_state_t tft_power_activity(ST7735_Config* config);
+
+/**
+ * @brief Estado actual de la pantalla.
+ */
+tft_power_state_t tft_power_state(void);
+
+/**
+ * @brief Duración del último despertar, desde SLPOUT hasta encender la luz de fondo.
+ *
+ * @return Microsegundos, o 0 si el panel todavía no se durmió.
+ */
+uint32_t tft_power_wake_us(void);
+
+#endif /* TFT_POWER_H */
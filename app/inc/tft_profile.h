@@ -0,0 +1,87 @@
+/**
+ * @file tft_profile.h
+ * @brief Medición del costo de dibujo de cada región de la pantalla TFT.
+ *
+ * Cada dibujo de una región (texto, ícono, gráfico) se envuelve entre TFT_PROFILE_BEGIN y
+ * TFT_PROFILE_END, que acumulan para esa región los bytes y transacciones SPI que generó y los
+ * microsegundos que tardó, además de un histograma de la duración de cada dibujo. Sin
+ * framebuffer los bytes son los que las primitivas enviaron al panel; con framebuffer el dibujo
+ * solo escribe en memoria, así que se cuentan los bytes de píxeles que dejó pendientes para el
+ * volcado y un rectángulo por transacción.
+ *
+ * Cada TFT_PROFILE_PERIOD_MS se registra en el log una línea de resumen con el total del periodo
+ * y las regiones más costosas. tft_profile_dump registra el histograma completo de cada región.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef TFT_PROFILE_H
+#define TFT_PROFILE_H
+
+#include "HT_st7735.h"
+#include <stdint.h>
+
+// Define para medir (1) o no (0) el costo de dibujo de cada región
+#define TFT_PROFILE 1
+
+// Periodo de la línea de resumen en el log
+#define TFT_PROFILE_PERIOD_MS 60000
+
+// Regiones que se pueden medir
+#define TFT_PROFILE_MAX_REGIONS 48
+
+// Intervalos del histograma: el primero llega hasta TFT_PROFILE_HIST_FIRST_US, cada uno dobla al
+// anterior y el último acumula todo lo que queda por encima
+#define TFT_PROFILE_HIST_BUCKETS 10
+#define TFT_PROFILE_HIST_FIRST_US 16
+
+#if TFT_PROFILE
+#define TFT_PROFILE_BEGIN(config, region) tft_profile_begin(config, region)
+#define TFT_PROFILE_END(config) tft_profile_end(config)
+#define TFT_PROFILE_REPORT(config) tft_profile_report(config)
+#else
+#define TFT_PROFILE_BEGIN(config, region) ((void)0)
+#define TFT_PROFILE_END(config) ((void)0)
+#define TFT_PROFILE_REPORT(config) ((void)0)
+#endif
+
+/**
+ * @brief Registra los nombres de las regiones y reinicia las mediciones.
+ *
+ * @param names Nombre de cada región, en el orden de su número; debe seguir existiendo.
+ * @param count Cantidad de regiones, hasta TFT_PROFILE_MAX_REGIONS.
+ */
+void tft_profile_init(const char* const* names, uint8_t count);
+
+/**
+ * @brief Empieza a medir el dibujo de una región. No se admiten mediciones anidadas.
+ *
+ * @param config Configuración de la pantalla sobre la que se dibuja.
+ * @param region Número de la región.
+ */
+void tft_profile_begin(const ST7735_Config* config, uint8_t region);
+
+/**
+ * @brief Termina la medición en curso y la suma a su región.
+ *
+ * @param config Configuración de la pantalla sobre la que se dibujó.
+ */
+void tft_profile_end(const ST7735_Config* config);
+
+/**
+ * @brief Registra la línea de resumen si ya pasó TFT_PROFILE_PERIOD_MS desde la anterior.
+ *
+ * Debe llamarse desde Task_TFTDisplay; los totales del periodo se reinician después de cada
+ * resumen.
+ *
+ * @param config Configuración de la pantalla, para incluir el tráfico SPI total del periodo.
+ */
+void tft_profile_report(const ST7735_Config* config);
+
+/**
+ * @brief Registra en el log el histograma de duraciones de cada región y lo reinicia.
+ */
+void tft_profile_dump(void);
+
+#endif /* TFT_PROFILE_H */
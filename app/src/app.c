@@ -1,3 +1,5 @@
+#include "backlight_handler.h"
+#include "button_handler.h"
 #include "gnss_uart_handler.h"
 #include "logger.h"
 #include "npk_uart_handler.h"
@@ -6,6 +8,7 @@
 #include "gnss_reader.h"
 #include "shared_data.h"
 #include "soil_sensor_reader.h"
+#include "tft_animation.h"
 #include "tft_manager.h"
 
 #include "freertos/FreeRTOS.h"
@@ -24,6 +27,7 @@ static void tft_display_init(void);
 TaskHandle_t taskProcessData_h;
 TaskHandle_t taskGNSSData_h;
 TaskHandle_t taskTFTDisplay_h;
+TaskHandle_t taskTFTFlush_h;
 
 SoilData_t soilData;
 GNSSElements_t gnssContext;
@@ -59,11 +63,18 @@ void app_init(void)
 
     configASSERT(pdPASS == ret);
 
-    ret = xTaskCreate(Task_TFTDisplay, "TFTDisplayTask", 3056, (void*)&tft_context,
-                      (tskIDLE_PRIORITY + 1ul), &taskTFTDisplay_h);
+    ret = xTaskCreatePinnedToCore(Task_TFTDisplay, "TFTDisplayTask", 3056, (void*)&tft_context,
+                                  (tskIDLE_PRIORITY + 1ul), &taskTFTDisplay_h, TFT_RENDER_CORE);
 
     configASSERT(pdPASS == ret);
 
+#if ST7735_USE_FRAMEBUFFER
+    ret = xTaskCreatePinnedToCore(Task_TFTFlush, "TFTFlushTask", 2048, (void*)&tft_context,
+                                  (tskIDLE_PRIORITY + 1ul), &taskTFTFlush_h, TFT_FLUSH_CORE);
+
+    configASSERT(pdPASS == ret);
+#endif
+
     ESP_LOGI(APP, "Task created successfully");
 }
 
@@ -109,6 +120,41 @@ static void tft_display_init(void)
         ESP_LOGE(APP, "Failed to initialize TFT SPI");
         ErrorHandler();
     }
+    // Sin PWM la luz de fondo queda encendida al máximo, sin atenuarse en reposo
+    if (init_tft_backlight() != ESP_OK)
+    {
+        ESP_LOGE(APP, "Failed to initialize TFT backlight");
+    }
+
+    tft_context.flush_request = xSemaphoreCreateBinary();
+    configASSERT(tft_context.flush_request != NULL);
+    tft_context.flush_done = xSemaphoreCreateBinary();
+    configASSERT(tft_context.flush_done != NULL);
+    xSemaphoreGive(tft_context.flush_done);
+
+    // Task_TFTDisplay se bloquea en este conjunto: un lugar por cada elemento de las dos colas
+    // de datos, uno para el tick de animación y uno para el botón que cambia de página
+    tft_context.tick = xSemaphoreCreateBinary();
+    configASSERT(tft_context.tick != NULL);
+    tft_animation_init(tft_context.tick);
+
+    tft_context.button = xSemaphoreCreateBinary();
+    configASSERT(tft_context.button != NULL);
+
+    tft_context.events = xQueueCreateSet(4);
+    configASSERT(tft_context.events != NULL);
+    BaseType_t ret = xQueueAddToSet(xQueueGNSSData, tft_context.events);
+    ret &= xQueueAddToSet(xQueueSoilData, tft_context.events);
+    ret &= xQueueAddToSet(tft_context.tick, tft_context.events);
+    ret &= xQueueAddToSet(tft_context.button, tft_context.events);
+    configASSERT(pdPASS == ret);
+
+    // El semáforo ya está en el conjunto antes de que la interrupción pueda liberarlo. Sin
+    // botón la pantalla sigue funcionando, solo que fija en el tablero
+    if (init_user_button(tft_context.button) != ESP_OK)
+    {
+        ESP_LOGE(APP, "Failed to initialize user button");
+    }
 }
 
 void ErrorHandler(void)
@@ -1,62 +1,166 @@
 #include "api_uart.h"
 #include "app.h"
+#include "gnss_uart_handler.h"
 #include "logger.h"
-#include <string.h>
+#include "number_formatter.h"
+
+const char* GNSS_READER = "[GNSS_READER]";
+
+/**
+ * @brief Registra los contadores de sentencias NMEA de cada tipo y la proporción perdida.
+ *
+ * @param parser Analizador cuyos contadores se registran.
+ */
+static void gnss_log_stats(const gnss_parser_t* parser)
+{
+    uint8_t count;
+    const nmea_stats_t* stats = gnss_parser_stats(parser, &count);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const uint32_t lost = stats[i].rejected + stats[i].truncated;
+        const uint32_t total = stats[i].accepted + lost;
+        if (!total)
+        {
+            continue;
+        }
+        // Pérdida en décimas de porcentaje
+        const uint32_t loss = (uint32_t)((uint64_t)lost * 1000 / total);
+        ESP_LOGI(GNSS_READER, "%-5s ok %lu, bad checksum %lu, truncated %lu, loss %lu.%lu%%",
+                 stats[i].id[0] ? stats[i].id : "?", (unsigned long)stats[i].accepted,
+                 (unsigned long)stats[i].rejected, (unsigned long)stats[i].truncated,
+                 (unsigned long)(loss / 10), (unsigned long)(loss % 10));
+    }
+}
+
+/**
+ * @brief Lee las líneas detectadas en la UART del GNSS y las entrega al analizador.
+ *
+ * Lee la línea del evento y, después, todas las demás líneas completas que ya estén en el
+ * búfer. Si la cola de eventos perdió un aviso, su línea se lee con el siguiente y el lector no
+ * queda una sentencia atrasado.
+ *
+ * @param port Puerto UART del GNSS.
+ * @param parser Analizador NMEA.
+ * @param[out] gnss_data Recibe los datos si con las líneas se completó un ciclo.
+ * @return true si se completó un ciclo RMC + GGA.
+ */
+static bool gnss_read_line(uart_t* port, gnss_parser_t* parser, GNSSData_t* gnss_data)
+{
+    uint8_t buffer[GNSS_READ_CHUNK_SIZE];
+    int pending = gnss_uart_line_length(port);
+    bool complete = false;
+
+    while (pending > 0)
+    {
+        const int len = uart_read_stream(
+            port, buffer, pending < GNSS_READ_CHUNK_SIZE ? pending : GNSS_READ_CHUNK_SIZE, 0);
+        if (len <= 0)
+        {
+            break;
+        }
+        complete |= gnss_parser_feed(parser, buffer, len, gnss_data);
+        pending -= len;
+        if (!pending)
+        {
+            pending = gnss_uart_next_line_length(port);
+        }
+    }
+    return complete;
+}
 
 /**
  * @brief Tarea para leer datos GNSS desde UART y procesarlos.
  *
- * Esta tarea lee continuamente datos GNSS desde un puerto UART especificado, analiza los datos,
- * y envía los datos GNSS analizados a una cola para su posterior procesamiento. La tarea se ejecuta en un
- * bucle infinito con un retraso de 1000 milisegundos entre cada operación de lectura.
+ * Esta tarea espera los eventos del controlador UART del GNSS. La detección de patrones avisa
+ * cada vez que llega un '\n', así que cada línea NMEA se entrega al analizador incremental
+ * (gnss_parser_feed) apenas termina de llegar y el ciclo se publica en cuanto llega su última
+ * sentencia, sin esperas fijas.
  *
  * @param pvParameters Puntero al contexto GNSS (GNSSElements_t) que contiene el puerto UART
  *                     y otra información necesaria para el procesamiento de datos GNSS.
  *
  * La función realiza los siguientes pasos:
- * 1. Limpia la estructura de datos GNSS.
- * 2. Lee datos desde el puerto UART en un búfer.
- * 3. Analiza los datos GNSS del búfer.
- * 4. Envía los datos GNSS analizados a una cola.
- * 5. Registra los datos GNSS incluyendo latitud, longitud, altitud, fecha, hora, número de satélites utilizados y estado de fijación.
+ * 1. Espera hasta GNSS_TIMEOUT_MS un evento de la UART.
+ * 2. Con cada fin de línea detectado, lee la línea y la entrega al analizador. Si se desbordó el
+ *    buffer de recepción, descarta lo recibido; el analizador cuenta la sentencia cortada.
+ * 3. Cuando se completa un ciclo (RMC y GGA), envía los datos GNSS a una cola.
+ * 4. Registra los datos GNSS incluyendo latitud, longitud, altitud, fecha, hora, número de satélites utilizados y estado de fijación.
+ *    También registra el modo de fijación, los DOP, la velocidad y los satélites en vista del
+ *    registro extendido (GSA, GSV, VTG).
+ * 5. Cada GNSS_STATS_EPOCHS ciclos, registra los contadores de sentencias aceptadas, rechazadas
+ *    y truncadas de cada tipo.
  *
  * Si los datos no se pueden enviar a la cola, se registra un mensaje de error.
  *
  * @note Esta función está diseñada para ejecutarse como una tarea de FreeRTOS.
  */
-const char* GNSS_READER = "[GNSS_READER]";
 void Task_GNSSData(void* pvParameters)
 {
     GNSSElements_t gnssContext = *(GNSSElements_t*)pvParameters;
-    uint8_t gnss_buffer[GNSS_MAX_MESSAGE_SIZE];
-    esp_err_t err;
+    gnss_parser_t parser;
+    uart_event_t event;
+    uint32_t epochs = 0;
+
+    gnss_parser_init(&parser);
 
     while (1)
     {
-        memset(&gnssContext.gnssData, 0, sizeof(GNSSData_t));
-        err = uart_read_data(&gnssContext.gnss_port, gnss_buffer, GNSS_MAX_MESSAGE_SIZE - 1,
-                             GNSS_TIMEOUT_MS);
-        // ESP_LOGI(GNSS_READER, "%s", (char*)gnss_buffer);
-        if (err == ESP_OK)
+        if (xQueueReceive(gnssContext.gnss_port.data_queue, &event,
+                          pdMS_TO_TICKS(GNSS_TIMEOUT_MS)) != pdTRUE)
         {
-            if (parse_gnss_buffer(gnss_buffer, strlen((char*)gnss_buffer), &gnssContext.gnssData))
+            ESP_LOGW(GNSS_READER, "No GNSS data in %d ms", GNSS_TIMEOUT_MS);
+            continue;
+        }
+
+        if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL)
+        {
+            ESP_LOGW(GNSS_READER, "GNSS UART overflow, input discarded");
+            gnss_uart_reset_input(&gnssContext.gnss_port);
+        }
+        else if (event.type == UART_PATTERN_DET &&
+                 gnss_read_line(&gnssContext.gnss_port, &parser, &gnssContext.gnssData))
+        {
+            // enviar a la cola
+            if (xQueueSend(xQueueGNSSData, &gnssContext.gnssData, 0) != pdPASS)
             {
+                ESP_LOGE(GNSS_READER, "Failed to send GNSS data to queue");
+            }
+            char position[64];
+            numfmt_t fmt;
+            numfmt_init(&fmt, position, sizeof(position));
+            // Las coordenadas se registran con toda su resolución (grados × 10^7)
+            numfmt_str(&fmt, "Lat: ");
+            numfmt_fixed(&fmt, gnssContext.gnssData.latitude, 7, 0, ' ');
+            numfmt_str(&fmt, ", Lon: ");
+            numfmt_fixed(&fmt, gnssContext.gnssData.longitude, 7, 0, ' ');
+            numfmt_str(&fmt, ", Alt: ");
+            numfmt_fixed(&fmt, numfmt_scale(gnssContext.gnssData.altitude, 2), 2, 0, ' ');
+            ESP_LOGI(GNSS_READER, "%s", position);
+            ESP_LOGI(GNSS_READER, "Date: %02d/%02d/%d Time: %02d:%02d, Sats: %d, Fix: %d",
+                     gnssContext.gnssData.day, gnssContext.gnssData.month,
+                     gnssContext.gnssData.year, gnssContext.gnssData.hour,
+                     gnssContext.gnssData.minute, gnssContext.gnssData.satellites_used,
+                     gnssContext.gnssData.fix_status);
 
-                // enviar a la cola
-                if (xQueueSend(xQueueGNSSData, &gnssContext.gnssData, 0) != pdPASS)
-                {
-                    ESP_LOGE(GNSS_READER, "Failed to send GNSS data to queue");
-                }
-                ESP_LOGI(GNSS_READER, "Lat: %.6f, Lon: %.6f, Alt: %.2f",
-                         gnssContext.gnssData.latitude, gnssContext.gnssData.longitude,
-                         gnssContext.gnssData.altitude);
-                ESP_LOGI(GNSS_READER, "Date: %02d/%02d/%d Time: %02d:%02d, Sats: %d, Fix: %d",
-                         gnssContext.gnssData.day, gnssContext.gnssData.month,
-                         gnssContext.gnssData.year, gnssContext.gnssData.hour,
-                         gnssContext.gnssData.minute, gnssContext.gnssData.satellites_used,
-                         gnssContext.gnssData.fix_status);
+            const GNSSExtData_t* ext = gnss_parser_extended(&parser);
+            numfmt_init(&fmt, position, sizeof(position));
+            numfmt_str(&fmt, "Mode: ");
+            numfmt_int(&fmt, ext->fix_mode, 0, ' ');
+            numfmt_str(&fmt, ", PDOP: ");
+            numfmt_fixed(&fmt, numfmt_scale(ext->pdop, 2), 2, 0, ' ');
+            numfmt_str(&fmt, ", VDOP: ");
+            numfmt_fixed(&fmt, numfmt_scale(ext->vdop, 2), 2, 0, ' ');
+            numfmt_str(&fmt, ", Speed: ");
+            numfmt_fixed(&fmt, numfmt_scale(ext->speed_kmh, 1), 1, 0, ' ');
+            numfmt_str(&fmt, " km/h");
+            ESP_LOGI(GNSS_READER, "%s, In view: %d, Used: %d", position, ext->satellite_count,
+                     ext->used_count);
+
+            if (++epochs % GNSS_STATS_EPOCHS == 0)
+            {
+                gnss_log_stats(&parser);
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }
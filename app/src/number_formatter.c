@@ -0,0 +1,112 @@
+#include "number_formatter.h"
+#include <stdbool.h>
+
+static const uint32_t NUMFMT_POW10[] = {1,      10,      100,      1000,      10000,
+                                        100000, 1000000, 10000000, 100000000, 1000000000};
+
+#define NUMFMT_MAX_DECIMALS 9
+
+/**
+ * @brief Agrega un carácter si queda espacio y mantiene el terminador.
+ */
+static void numfmt_put(numfmt_t* fmt, char c)
+{
+    if (fmt->len + 1 < fmt->size)
+    {
+        fmt->buf[fmt->len++] = c;
+        fmt->buf[fmt->len] = '\0';
+    }
+}
+
+void numfmt_init(numfmt_t* fmt, char* buf, size_t size)
+{
+    fmt->buf = buf;
+    fmt->size = size;
+    fmt->len = 0;
+    if (size)
+    {
+        buf[0] = '\0';
+    }
+}
+
+void numfmt_str(numfmt_t* fmt, const char* str)
+{
+    while (*str)
+    {
+        numfmt_put(fmt, *str++);
+    }
+}
+
+void numfmt_int(numfmt_t* fmt, int32_t value, uint8_t width, char pad)
+{
+    numfmt_fixed(fmt, value, 0, width, pad);
+}
+
+void numfmt_fixed(numfmt_t* fmt, int32_t value, uint8_t decimals, uint8_t width, char pad)
+{
+    char digits[10];
+    uint8_t count = 0;
+    const bool negative = value < 0;
+    uint32_t magnitude = negative ? -(uint32_t)value : (uint32_t)value;
+
+    if (decimals > NUMFMT_MAX_DECIMALS)
+    {
+        decimals = NUMFMT_MAX_DECIMALS;
+    }
+
+    // Dígitos de menor a mayor peso, con al menos un dígito antes del punto decimal
+    do
+    {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude || count <= decimals);
+
+    uint8_t length = count + (decimals ? 1 : 0) + (negative ? 1 : 0);
+
+    if (pad != '0')
+    {
+        for (; length < width; length++)
+        {
+            numfmt_put(fmt, pad);
+        }
+    }
+    if (negative)
+    {
+        numfmt_put(fmt, '-');
+    }
+    for (; length < width; length++)
+    {
+        numfmt_put(fmt, '0');
+    }
+
+    while (count)
+    {
+        if (count == decimals)
+        {
+            numfmt_put(fmt, '.');
+        }
+        numfmt_put(fmt, digits[--count]);
+    }
+}
+
+int32_t numfmt_scale(float value, uint8_t decimals)
+{
+    if (decimals > NUMFMT_MAX_DECIMALS)
+    {
+        decimals = NUMFMT_MAX_DECIMALS;
+    }
+
+    float scaled = value * (float)NUMFMT_POW10[decimals];
+    float rounded = scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f;
+
+    // Convertir a entero un valor fuera de rango (o NaN) no está definido: se satura
+    if (rounded >= 2147483648.0f)
+    {
+        return INT32_MAX;
+    }
+    if (!(rounded >= (float)INT32_MIN))
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)rounded;
+}
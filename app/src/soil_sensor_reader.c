@@ -3,6 +3,7 @@
 #include "app.h"
 #include "esp_err.h"
 #include "logger.h"
+#include "number_formatter.h"
 #include "shared_data.h"
 #include <string.h>
 
@@ -208,12 +209,19 @@ void Task_processData(void* soilData)
 
         // send data to queue
         parse_soil_data(response_buffer, sensor_data);
+        char moisture[8], temperature[8], ph[8];
+        numfmt_t fmt;
+        numfmt_init(&fmt, moisture, sizeof(moisture));
+        numfmt_fixed(&fmt, numfmt_scale(sensor_data->moisture, 1), 1, 0, ' ');
+        numfmt_init(&fmt, temperature, sizeof(temperature));
+        numfmt_fixed(&fmt, numfmt_scale(sensor_data->temperature, 1), 1, 0, ' ');
+        numfmt_init(&fmt, ph, sizeof(ph));
+        numfmt_fixed(&fmt, numfmt_scale(sensor_data->pH, 1), 1, 0, ' ');
         ESP_LOGI(TAG,
-                 "Soil Data - Moisture: %.1f%%, Temperature: %.1f°C, Conductivity: %d, pH: %.1f, "
+                 "Soil Data - Moisture: %s%%, Temperature: %s°C, Conductivity: %d, pH: %s, "
                  "N: %d, P: %d, K: %d",
-                 sensor_data->moisture, sensor_data->temperature, sensor_data->conductivity,
-                 sensor_data->pH, sensor_data->nitrogen, sensor_data->phosphorus,
-                 sensor_data->potassium);
+                 moisture, temperature, sensor_data->conductivity, ph, sensor_data->nitrogen,
+                 sensor_data->phosphorus, sensor_data->potassium);
 
         if (pdPASS != xQueueSend(xQueueSoilData, sensor_data, portMAX_DELAY))
         {
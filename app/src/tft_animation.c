@@ -0,0 +1,139 @@
+#include "tft_animation.h"
+#include "freertos/timers.h"
+#include "logger.h"
+
+static const char* TAG = "[TFT_ANIMATION]";
+
+static tft_animation_t* animations[TFT_ANIMATION_MAX];
+static uint8_t animation_count;
+static TimerHandle_t animation_timer;
+static TickType_t last_frame;
+static TickType_t min_frame_ticks; // separación mínima entre cuadros, según el tope global
+
+/**
+ * @brief Callback del temporizador: despierta a Task_TFTDisplay por medio del semáforo.
+ *
+ * @param timer Temporizador cuyo ID es el semáforo de tick.
+ */
+static void tft_animation_timer_callback(TimerHandle_t timer)
+{
+    xSemaphoreGive((SemaphoreHandle_t)pvTimerGetTimerID(timer));
+}
+
+/**
+ * @brief Programa el temporizador para la animación más próxima, respetando el tope de cuadros.
+ *
+ * @param now Tick actual.
+ */
+static void tft_animation_schedule(TickType_t now)
+{
+    if (!animation_count)
+    {
+        xTimerStop(animation_timer, 0);
+        return;
+    }
+
+    TickType_t delay = portMAX_DELAY;
+    for (uint8_t i = 0; i < animation_count; i++)
+    {
+        int32_t remaining = (int32_t)(animations[i]->due - now);
+        TickType_t wait = remaining > 0 ? (TickType_t)remaining : 0;
+        if (wait < delay)
+        {
+            delay = wait;
+        }
+    }
+
+    // No antes de que pase la separación mínima desde el último cuadro
+    int32_t cap = (int32_t)(last_frame + min_frame_ticks - now);
+    if (cap > 0 && (TickType_t)cap > delay)
+    {
+        delay = (TickType_t)cap;
+    }
+    if (delay == 0)
+    {
+        delay = 1;
+    }
+
+    xTimerChangePeriod(animation_timer, delay, 0);
+}
+
+void tft_animation_init(SemaphoreHandle_t tick)
+{
+    min_frame_ticks = pdMS_TO_TICKS(1000 / TFT_ANIMATION_MAX_FPS);
+    if (!min_frame_ticks)
+    {
+        min_frame_ticks = 1;
+    }
+
+    // Sin cuadros previos, la primera animación no tiene que esperar al tope
+    last_frame = xTaskGetTickCount() - min_frame_ticks;
+
+    animation_timer = xTimerCreate("TFTAnim", min_frame_ticks, pdFALSE, (void*)tick,
+                                   tft_animation_timer_callback);
+    configASSERT(animation_timer != NULL);
+}
+
+bool tft_animation_start(tft_animation_t* anim)
+{
+    if (anim->running)
+    {
+        return true;
+    }
+    if (animation_count == TFT_ANIMATION_MAX)
+    {
+        ESP_LOGE(TAG, "Too many animations");
+        return false;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    anim->frame = 0;
+    anim->due = now;
+    anim->running = true;
+    animations[animation_count++] = anim;
+
+    tft_animation_schedule(now);
+    return true;
+}
+
+void tft_animation_stop(tft_animation_t* anim)
+{
+    if (!anim->running)
+    {
+        return;
+    }
+
+    anim->running = false;
+    for (uint8_t i = 0; i < animation_count; i++)
+    {
+        if (animations[i] == anim)
+        {
+            animations[i] = animations[--animation_count];
+            break;
+        }
+    }
+
+    tft_animation_schedule(xTaskGetTickCount());
+}
+
+void tft_animation_run(ST7735_Config* config)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    for (uint8_t i = 0; i < animation_count; i++)
+    {
+        tft_animation_t* anim = animations[i];
+        if ((int32_t)(now - anim->due) < 0)
+        {
+            continue;
+        }
+
+        anim->draw(config, anim);
+        anim->frame++;
+        // Si la tarea se atrasó, se descartan los cuadros perdidos en lugar de acumularlos
+        anim->due = now + pdMS_TO_TICKS(anim->period_ms);
+        last_frame = now;
+    }
+
+    tft_animation_schedule(now);
+}
@@ -0,0 +1,155 @@
+#include "tft_benchmark.h"
+#include "HT_st7735.h"
+#include "HT_st7735_emu.h"
+#include "HT_st7735_glyph_cache.h"
+#include "esp_timer.h"
+#include "logger.h"
+#include "tft_manager.h"
+
+#define BENCH_IMAGE_SIZE 32
+
+static const char* TAG = "[TFT_BENCH]";
+
+static uint16_t bench_image[BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE];
+
+typedef enum
+{
+    BENCH_PIXEL,
+    BENCH_CHAR,
+    BENCH_STRING,
+    BENCH_FILL,
+    BENCH_IMAGE,
+    BENCH_FRAME,
+    BENCH_COUNT
+} bench_case_t;
+
+static const char* const bench_names[BENCH_COUNT] = {
+    [BENCH_PIXEL] = "pixel", [BENCH_CHAR] = "char",   [BENCH_STRING] = "string",
+    [BENCH_FILL] = "fill",   [BENCH_IMAGE] = "image", [BENCH_FRAME] = "frame",
+};
+
+static const GNSSData_t bench_gnss = {.latitude = 46371080,
+                                      .longitude = -740828130,
+                                      .altitude = 2562.0f,
+                                      .hour = 14,
+                                      .minute = 37,
+                                      .day = 12,
+                                      .month = 10,
+                                      .year = 24,
+                                      .fix_status = 1,
+                                      .satellites_used = 9};
+
+static const SoilData_t bench_soil = {.temperature = 23.4f,
+                                      .moisture = 41.7f,
+                                      .conductivity = 312,
+                                      .pH = 6.8f,
+                                      .nitrogen = 45,
+                                      .phosphorus = 21,
+                                      .potassium = 118,
+                                      .status = 1};
+
+/**
+ * @brief Dibuja una vez el caso de prueba indicado.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param bench Caso de prueba a dibujar.
+ * @param i Número de iteración, usado para variar el contenido entre repeticiones.
+ */
+static void bench_draw(TFTElements_t* tft_elements, bench_case_t bench, int i)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+    const uint16_t color = (i & 1) ? ST7735_WHITE : ST7735_YELLOW;
+
+    switch (bench)
+    {
+    case BENCH_PIXEL:
+        st7735_draw_pixel(config, 10 + i, 10, color);
+        break;
+    case BENCH_CHAR:
+        st7735_write_char(config, 10, 10, '0' + i, Font_7x10, color, ST7735_BLACK);
+        break;
+    case BENCH_STRING:
+        st7735_write_string(config, 1, 21, "Lt: 4.637108", Font_7x10, color, ST7735_BLACK);
+        break;
+    case BENCH_FILL:
+        st7735_fill_screen(config, (i & 1) ? ST7735_BLACK : ST7735_NAVY);
+        break;
+    case BENCH_IMAGE:
+        st7735_draw_image(config, 64, 24, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, bench_image);
+        break;
+    case BENCH_FRAME:
+    {
+        GNSSData_t gnss = bench_gnss;
+        SoilData_t soil = bench_soil;
+        gnss.minute = (gnss.minute + i) % 60;
+        soil.moisture += i;
+        tft_render_frame(tft_elements, &gnss, &soil);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Ejecuta el benchmark de la pantalla y registra los resultados.
+ *
+ * Cada caso se repite TFT_BENCHMARK_ITERATIONS veces. Tras cada repetición se envía el
+ * framebuffer al panel, de modo que los bytes y transacciones medidos son los que realmente
+ * viajan por el bus, con o sin framebuffer. El tiempo incluye el dibujo y el envío.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ */
+void tft_benchmark_run(TFTElements_t* tft_elements)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+
+    for (int i = 0; i < BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE; i++)
+    {
+        bench_image[i] = ST7735_COLOR565((i * 8), (i / 4), (255 - i * 8));
+    }
+
+    ESP_LOGI(TAG, "%-8s %10s %8s %10s", "case", "us/iter", "trans", "bytes");
+
+    for (bench_case_t bench = 0; bench < BENCH_COUNT; bench++)
+    {
+        st7735_flush(config);
+        st7735_reset_stats(config);
+
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < TFT_BENCHMARK_ITERATIONS; i++)
+        {
+            bench_draw(tft_elements, bench, i);
+            st7735_flush(config);
+        }
+        int64_t elapsed = esp_timer_get_time() - start;
+
+        ST7735_Stats stats = st7735_get_stats(config);
+        ESP_LOGI(TAG, "%-8s %10lld %8lu %10lu", bench_names[bench],
+                 (long long)(elapsed / TFT_BENCHMARK_ITERATIONS),
+                 (unsigned long)(stats.transactions / TFT_BENCHMARK_ITERATIONS),
+                 (unsigned long)(stats.bytes / TFT_BENCHMARK_ITERATIONS));
+    }
+
+#if ST7735_USE_EMULATOR
+    // Un cuadro del tablero sobre la pantalla ya dibujada: mide el redibujado redundante y
+    // vuelca la imagen para compararla con la de referencia
+    st7735_emu_reset_stats();
+    bench_draw(tft_elements, BENCH_FRAME, 0);
+    st7735_flush(config);
+
+    ST7735_EmuStats emu = st7735_emu_get_stats();
+    ESP_LOGI(TAG, "emulator: pixel writes %lu redundant %lu offscreen %lu",
+             (unsigned long)emu.pixel_writes, (unsigned long)emu.redundant_writes,
+             (unsigned long)emu.offscreen_writes);
+    st7735_emu_dump("dashboard");
+#endif
+
+    ST7735_GlyphCacheStats cache = st7735_glyph_cache_get_stats();
+    ESP_LOGI(TAG, "glyph cache: hits %lu misses %lu evictions %lu bypass %lu",
+             (unsigned long)cache.hits, (unsigned long)cache.misses,
+             (unsigned long)cache.evictions, (unsigned long)cache.bypass);
+
+    st7735_fill_screen(config, ST7735_BLACK);
+    st7735_flush(config);
+}
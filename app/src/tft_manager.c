@@ -1,90 +1,326 @@
 #include "tft_manager.h"
 #include "HT_st7735.h"
 #include "app.h"
+#include "button_handler.h"
+#include "esp_system.h"
+#include "esp_timer.h"
 #include "logger.h"
+#include "number_formatter.h"
+#include "tft_animation.h"
+#include "tft_benchmark.h"
+#include "tft_power.h"
+#include "tft_profile.h"
+#include <string.h>
+
+static const char* TAG = "[TFT_MANAGER]";
 
 #define ICON_WIDTH 7
 #define ICON_HEIGHT 10
 
-typedef struct
-{
-    int x1;
-    int y1;
-    int x2;
-    int y2;
-} tft_cords_t;
+// Gráfico de tendencia de las métricas de suelo: una columna por muestra
+#define SOIL_CHART_X 114
+#define SOIL_CHART_Y 45
+#define SOIL_CHART_WIDTH 46
+#define SOIL_CHART_HEIGHT 35
+
+// Caracteres que recuerda cada widget de texto, incluido el terminador
+#define TFT_WIDGET_TEXT_MAX 24
 
-static const uint16_t SOIL_SENSOR_ICON[] = {0X0D, 0X69, 0X5A, 0X2C, 0X08, 0X08, 0X08, 0X2A, 0X7F};
+// Pulsaciones del botón más cortas que esto son rebotes; las más largas vuelven al tablero
+#define TFT_BUTTON_DEBOUNCE_MS 30
+#define TFT_BUTTON_LONG_PRESS_MS 800
+
+static const uint16_t SOIL_SENSOR_ICON[] = {0X0D, 0X69, 0X5A, 0X2C, 0X08,
+                                            0X08, 0X08, 0X2A, 0X7F, 0X00};
 static const uint16_t GPS_ICON[] = {0x1C, 0x3E, 0x7F, 0x63, 0x63, 0X77, 0X3E, 0X1C, 0X08, 0X08};
 // static const uint16_t LORA_ICON[] = {0X22,0X49,0X49,0X22,0X00,0X08,0X08,0X08,0X1C,0X3E};
 
 /**
  * @file tft_manager.c
- * @brief Gestión de las regiones de la pantalla TFT.
- *
- * Este archivo contiene la definición de las regiones de la pantalla TFT y sus coordenadas.
- * Las regiones están definidas en la enumeración `tft_regions` y sus coordenadas están
- * almacenadas en el array `tft_region_coords`.
+ * @brief Gestión de las páginas y regiones de la pantalla TFT.
  *
- * Enumeración `tft_regions`: Regiones de la pantalla TFT. De los datos de la aplicación
+ * La pantalla muestra una página a la vez: el tablero, el detalle GNSS, la salud del sensor de
+ * suelo y el estado del sistema. Cada evento actualiza el modelo (`tft_model`) de todas las
+ * páginas, pero solo la página visible dibuja; las ocultas no generan tráfico SPI y se dibujan
+ * completas desde el modelo al mostrarse. El botón de usuario pasa a la página siguiente y, con
+ * una pulsación larga, vuelve al tablero; en el tablero, la pulsación larga cambia la métrica
+ * del gráfico de tendencia. Sin pulsaciones la pantalla baja su consumo por etapas
+ * (tft_power); mientras el panel duerme tampoco se dibuja la página visible.
  *
- * Estructura `tft_cords_t`:
- * - x1: Coordenada x inicial de la región.
- * - y1: Coordenada y inicial de la región.
- * - x2: Coordenada x final de la región.
- * - y2: Coordenada y final de la región.
+ * Las regiones se describen una sola vez en `TFT_LAYOUT`, con las páginas en que aparecen y sus
+ * coordenadas inclusivas (x1, y1) - (x2, y2). De esa lista salen la enumeración `tft_regions`,
+ * las comprobaciones de límites en tiempo de compilación y la tabla `tft_layout`, que guarda
+ * para cada región las ventanas de dirección ya calculadas:
+ * - area: la región completa, que se borra cuando su contenido deja de ser válido.
+ * - text: la línea de texto, con el alto de TFT_FONT y el ancho de las columnas que caben;
+ *   su fila superior es la línea base del texto.
+ * - columns: caracteres que caben en la línea; el texto más largo se corta, nunca pasa a la
+ *   región vecina.
  *
- * Array `tft_region_coords`:
- * - Almacena las coordenadas de cada región definida en `tft_regions`.
+ * Dibujar una región no requiere ningún cálculo de geometría en tiempo de ejecución. El
+ * preprocesador no puede comparar todas las regiones entre sí, así que los solapamientos entre
+ * regiones de una misma página los detecta tft_layout_check: la prueba de host
+ * (tools/host/test_tft_widgets.c) falla si encuentra alguno, y el equipo los informa al arrancar.
  */
+
+// Fuente de todas las regiones de texto; sus medidas se usan para precalcular la tabla
+#define TFT_FONT Font_7x10
+#define TFT_FONT_WIDTH 7
+#define TFT_FONT_HEIGHT 10
+
+typedef enum
+{
+    TFT_PAGE_DASHBOARD,
+    TFT_PAGE_GNSS,
+    TFT_PAGE_SENSOR,
+    TFT_PAGE_SYSTEM,
+    TFT_PAGE_COUNT
+} tft_page_t;
+
+// Páginas en las que aparece una región
+#define PAGE_DASH (1u << TFT_PAGE_DASHBOARD)
+#define PAGE_GNSS (1u << TFT_PAGE_GNSS)
+#define PAGE_SENSOR (1u << TFT_PAGE_SENSOR)
+#define PAGE_SYSTEM (1u << TFT_PAGE_SYSTEM)
+#define PAGE_DETAIL (PAGE_GNSS | PAGE_SENSOR | PAGE_SYSTEM)
+
+// X(región, páginas, x1, y1, x2, y2)
+#define TFT_LAYOUT(X)                                                                            \
+    X(MODE_REGION, PAGE_DASH, 1, 1, 30, 20)                                                      \
+    X(GPS_ICON_REGION, PAGE_DASH, 31, 1, 44, 20)                                                 \
+    X(SOIL_SENSOR_ICON_REGION, PAGE_DASH, 45, 1, 58, 20)                                         \
+    X(LORA_ICON_REGION, PAGE_DASH, 59, 1, 72, 20)                                                \
+    X(DATE_REGION, PAGE_DASH, 73, 1, 150, 10)                                                    \
+    X(TIME_REGION, PAGE_DASH, 73, 11, 150, 20)                                                   \
+    X(BATTERY_REGION, PAGE_DASH, 151, 1, 159, 20)                                                \
+    X(ALTITUDE_REGION, PAGE_DASH, 1, 21, 60, 30)                                                 \
+    X(LATITUDE_REGION, PAGE_DASH, 61, 21, 159, 30)                                               \
+    X(LONGITUDE_REGION, PAGE_DASH, 61, 31, 159, 40)                                              \
+    X(PH_REGION, PAGE_DASH, 1, 31, 60, 40)                                                       \
+    X(TEMPERATURE_REGION, PAGE_DASH, 1, 41, 56, 50)                                              \
+    X(HUMIDITY_REGION, PAGE_DASH, 1, 51, 56, 60)                                                 \
+    X(CONDUCTIVITY_REGION, PAGE_DASH, 1, 61, 56, 79)                                             \
+    X(NITROGEN_REGION, PAGE_DASH, 57, 45, 112, 54)                                               \
+    X(PHOSPHORUS_REGION, PAGE_DASH, 57, 55, 112, 64)                                             \
+    X(POTASSIUM_REGION, PAGE_DASH, 57, 65, 112, 79)                                              \
+    X(SOIL_CHART_REGION, PAGE_DASH, SOIL_CHART_X, SOIL_CHART_Y,                                  \
+      SOIL_CHART_X + SOIL_CHART_WIDTH - 1, SOIL_CHART_Y + SOIL_CHART_HEIGHT - 1)                 \
+    X(PAGE_TITLE_REGION, PAGE_DETAIL, 1, 0, 159, 9)                                              \
+    X(GNSS_FIX_REGION, PAGE_GNSS, 1, 10, 79, 19)                                                 \
+    X(GNSS_SATS_REGION, PAGE_GNSS, 80, 10, 159, 19)                                              \
+    X(GNSS_HDOP_REGION, PAGE_GNSS, 1, 20, 79, 29)                                                \
+    X(GNSS_ALTITUDE_REGION, PAGE_GNSS, 80, 20, 159, 29)                                          \
+    X(GNSS_LATITUDE_REGION, PAGE_GNSS, 1, 30, 159, 39)                                           \
+    X(GNSS_LONGITUDE_REGION, PAGE_GNSS, 1, 40, 159, 49)                                          \
+    X(GNSS_TIME_REGION, PAGE_GNSS, 1, 50, 159, 59)                                               \
+    X(GNSS_UPDATES_REGION, PAGE_GNSS, 1, 60, 159, 69)                                            \
+    X(SENSOR_STATUS_REGION, PAGE_SENSOR, 1, 10, 159, 19)                                         \
+    X(SENSOR_READS_REGION, PAGE_SENSOR, 1, 20, 159, 29)                                          \
+    X(SENSOR_ERRORS_REGION, PAGE_SENSOR, 1, 30, 159, 39)                                         \
+    X(SENSOR_SUCCESS_REGION, PAGE_SENSOR, 1, 40, 159, 49)                                        \
+    X(SENSOR_MOISTURE_REGION, PAGE_SENSOR, 1, 50, 159, 59)                                       \
+    X(SENSOR_TEMPERATURE_REGION, PAGE_SENSOR, 1, 60, 159, 69)                                    \
+    X(SENSOR_LAST_OK_REGION, PAGE_SENSOR, 1, 70, 159, 79)                                        \
+    X(SYSTEM_LORA_REGION, PAGE_SYSTEM, 1, 10, 159, 19)                                           \
+    X(SYSTEM_STORAGE_REGION, PAGE_SYSTEM, 1, 20, 159, 29)                                        \
+    X(SYSTEM_UPTIME_REGION, PAGE_SYSTEM, 1, 30, 159, 39)                                         \
+    X(SYSTEM_HEAP_REGION, PAGE_SYSTEM, 1, 40, 159, 49)                                           \
+    X(SYSTEM_TFT_REGION, PAGE_SYSTEM, 1, 50, 159, 59)                                           \
+    X(SYSTEM_WAKE_REGION, PAGE_SYSTEM, 1, 60, 159, 69)
+
+#define TFT_LAYOUT_ENUM(name, pages, x1, y1, x2, y2) name,
 typedef enum
 {
-    MODE_REGION,
-    GPS_ICON_REGION,
-    SOIL_SENSOR_ICON_REGION,
-    LORA_ICON_REGION,
-    DATE_REGION,
-    TIME_REGION,
-    BATTERY_REGION,
-    ALTITUDE_REGION,
-    LATITUDE_REGION,
-    LONGITUDE_REGION,
-    TEMPERATURE_REGION,
-    HUMIDITY_REGION,
-    CONDUCTIVITY_REGION,
-    PH_REGION,
-    NITROGEN_REGION,
-    PHOSPHORUS_REGION,
-    POTASSIUM_REGION,
-    TFT_REGION_COUNT
+    TFT_LAYOUT(TFT_LAYOUT_ENUM) TFT_REGION_COUNT
 } tft_regions;
 
-const tft_cords_t tft_region_coords[TFT_REGION_COUNT] = {
-    [MODE_REGION] = {.x1 = 1, .y1 = 1, .x2 = 30, .y2 = 20},
-    [GPS_ICON_REGION] = {.x1 = 31, .y1 = 1, .x2 = 44, .y2 = 20},
-    [SOIL_SENSOR_ICON_REGION] = {.x1 = 45, .y1 = 1, .x2 = 58, .y2 = 20},
-    [LORA_ICON_REGION] = {.x1 = 59, .y1 = 1, .x2 = 72, .y2 = 20},
-    [DATE_REGION] = {.x1 = 70, .y1 = 1, .x2 = 150, .y2 = 10},
-    [TIME_REGION] = {.x1 = 70, .y1 = 11, .x2 = 150, .y2 = 20},
-    [BATTERY_REGION] = {.x1 = 151, .y1 = 1, .x2 = 160, .y2 = 20},
-    [ALTITUDE_REGION] = {.x1 = 1, .y1 = 21, .x2 = 60, .y2 = 30},
-    [PH_REGION] = {.x1 = 1, .y1 = 31, .x2 = 60, .y2 = 40},
-    [LATITUDE_REGION] = {.x1 = 61, .y1 = 21, .x2 = 160, .y2 = 30},
-    [LONGITUDE_REGION] = {.x1 = 61, .y1 = 31, .x2 = 160, .y2 = 40},
-    [TEMPERATURE_REGION] = {.x1 = 1, .y1 = 41, .x2 = 50, .y2 = 50},
-    [HUMIDITY_REGION] = {.x1 = 1, .y1 = 51, .x2 = 50, .y2 = 60},
-    [CONDUCTIVITY_REGION] = {.x1 = 1, .y1 = 61, .x2 = 50, .y2 = 80},
-    [NITROGEN_REGION] = {.x1 = 55, .y1 = 45, .x2 = 140, .y2 = 54},
-    [PHOSPHORUS_REGION] = {.x1 = 55, .y1 = 55, .x2 = 140, .y2 = 64},
-    [POTASSIUM_REGION] = {.x1 = 55, .y1 = 65, .x2 = 140, .y2 = 80}
-    };
+// Cada región debe estar dentro de la pantalla y tener al menos una línea de texto de alto
+#define TFT_LAYOUT_CHECK(name, pages, x1, y1, x2, y2)                                            \
+    _Static_assert((x1) <= (x2) && (x2) < ST7735_WIDTH && (y1) <= (y2) &&                        \
+                       (y2) < ST7735_HEIGHT && (y2) - (y1) + 1 >= TFT_FONT_HEIGHT,               \
+                   #name " fuera de la pantalla");
+TFT_LAYOUT(TFT_LAYOUT_CHECK)
+
+typedef struct
+{
+    ST7735_Window area; // región completa
+    ST7735_Window text; // línea de texto alineada arriba a la izquierda
+    uint8_t columns;    // caracteres que caben en `text`
+    uint8_t pages;      // máscara de las páginas en que aparece
+} tft_layout_t;
+
+#define TFT_LAYOUT_COLUMNS(x1, x2) (((x2) - (x1) + 1) / TFT_FONT_WIDTH)
+#define TFT_LAYOUT_TEXT_X2(x1, x2) ((x1) + TFT_LAYOUT_COLUMNS(x1, x2) * TFT_FONT_WIDTH - 1)
+#define TFT_LAYOUT_ENTRY(name, pages_mask, x1, y1, x2, y2)                                       \
+    [name] = {.area = ST7735_WINDOW(x1, y1, x2, y2),                                             \
+              .text = ST7735_WINDOW(x1, y1, TFT_LAYOUT_TEXT_X2(x1, x2),                          \
+                                    (y1) + TFT_FONT_HEIGHT - 1),                                 \
+              .columns = TFT_LAYOUT_COLUMNS(x1, x2),                                             \
+              .pages = (pages_mask)},
+
+static const tft_layout_t tft_layout[TFT_REGION_COUNT] = {TFT_LAYOUT(TFT_LAYOUT_ENTRY)};
+
+#if TFT_PROFILE
+// Nombres de las regiones para las mediciones de tft_profile
+#define TFT_LAYOUT_NAME(name, pages, x1, y1, x2, y2) [name] = #name,
+static const char* const tft_region_names[TFT_REGION_COUNT] = {TFT_LAYOUT(TFT_LAYOUT_NAME)};
+_Static_assert(TFT_REGION_COUNT <= TFT_PROFILE_MAX_REGIONS, "TFT_PROFILE_MAX_REGIONS muy bajo");
+#endif
+
+/**
+ * Métricas del sensor de suelo que guarda el gráfico de tendencia.
+ */
+typedef enum
+{
+    SOIL_METRIC_MOISTURE,
+    SOIL_METRIC_TEMPERATURE,
+    SOIL_METRIC_CONDUCTIVITY,
+    SOIL_METRIC_PH,
+    SOIL_METRIC_NITROGEN,
+    SOIL_METRIC_PHOSPHORUS,
+    SOIL_METRIC_POTASSIUM,
+    SOIL_METRIC_COUNT
+} soil_metric_t;
+
+/**
+ * Escala fija de cada métrica en el gráfico. Al ser fija, una muestra nueva nunca obliga a
+ * redibujar las anteriores; los valores fuera de rango se recortan al borde.
+ */
+typedef struct
+{
+    float min;
+    float max;
+    uint16_t color;
+} soil_metric_scale_t;
+
+static const soil_metric_scale_t soil_metric_scales[SOIL_METRIC_COUNT] = {
+    [SOIL_METRIC_MOISTURE] = {.min = 0.0f, .max = 100.0f, .color = ST7735_CYAN},
+    [SOIL_METRIC_TEMPERATURE] = {.min = 0.0f, .max = 50.0f, .color = ST7735_ORANGE},
+    [SOIL_METRIC_CONDUCTIVITY] = {.min = 0.0f, .max = 2000.0f, .color = ST7735_YELLOW},
+    [SOIL_METRIC_PH] = {.min = 3.0f, .max = 9.0f, .color = ST7735_MAGENTA},
+    [SOIL_METRIC_NITROGEN] = {.min = 0.0f, .max = 200.0f, .color = ST7735_GREEN},
+    [SOIL_METRIC_PHOSPHORUS] = {.min = 0.0f, .max = 200.0f, .color = ST7735_GREEN},
+    [SOIL_METRIC_POTASSIUM] = {.min = 0.0f, .max = 200.0f, .color = ST7735_GREEN},
+};
+
+/**
+ * Anillo de muestras recientes por métrica. La posición del anillo es también la columna del
+ * gráfico: cada muestra nueva se dibuja en la columna siguiente (barrido) y la columna posterior,
+ * que contiene la muestra más antigua, se borra para marcar el cursor. Las muestras se guardan
+ * aunque el tablero no esté visible y se dibujan al volver a mostrarlo.
+ */
+typedef struct
+{
+    float samples[SOIL_METRIC_COUNT][SOIL_CHART_WIDTH];
+    uint8_t head;         // columna de la muestra más reciente
+    uint8_t count;        // muestras guardadas, hasta SOIL_CHART_WIDTH
+    uint8_t pending;      // muestras más recientes que todavía no se dibujaron
+    bool redraw;          // la pantalla no muestra el gráfico: hay que dibujarlo completo
+    soil_metric_t metric; // métrica visible
+} soil_chart_t;
+
+static soil_chart_t soil_chart = {
+    .head = SOIL_CHART_WIDTH - 1, .redraw = true, .metric = SOIL_METRIC_MOISTURE};
+
+/**
+ * Estado retenido de cada región de la pantalla: lo último que se dibujó en ella. Permite
+ * omitir las regiones cuyo contenido no cambió y, en las de texto, redibujar solo los
+ * caracteres distintos.
+ */
+typedef struct
+{
+    char text[TFT_WIDGET_TEXT_MAX]; // texto dibujado (vacío en las regiones de ícono)
+    uint8_t length;                 // caracteres de `text`
+    const uint16_t* icon;           // ícono dibujado, o NULL en las regiones de texto
+    uint16_t color;
+    uint16_t bgcolor;
+    bool valid; // false si la región no refleja lo que hay en pantalla
+} tft_widget_t;
+
+static tft_widget_t tft_widgets[TFT_REGION_COUNT];
+
+/**
+ * Modelo de todas las páginas. Cada evento lo actualiza, sea cual sea la página visible; las
+ * páginas solo lo leen al dibujarse.
+ */
+typedef struct
+{
+    GNSSData_t gnss;         // último dato GNSS
+    uint32_t gnss_updates;   // datos GNSS recibidos
+    SoilData_t soil;         // última lectura del sensor de suelo
+    uint32_t soil_reads;     // lecturas recibidas, válidas o no
+    uint32_t soil_errors;    // lecturas sin respuesta del sensor
+    TickType_t soil_last_ok; // momento de la última lectura válida
+    float moisture_min;
+    float moisture_max;
+    float temperature_min;
+    float temperature_max;
+} tft_model_t;
+
+static tft_model_t tft_model;
+
+/**
+ * Página de la pantalla. `render` la dibuja desde `tft_model`; como cada región recuerda lo que
+ * muestra, llamarla de nuevo solo envía lo que cambió.
+ */
+typedef struct
+{
+    const char* title;
+    void (*render)(TFTElements_t* tft_elements);
+} tft_page_def_t;
+
+static tft_page_t tft_page = TFT_PAGE_DASHBOARD; // página visible
 
-static void draw_icon(ST7735_Config* config, uint16_t x, uint16_t y, const uint16_t* icon,
+
+static void draw_icon(ST7735_Config* config, tft_regions region, const uint16_t* icon,
                       uint16_t color);
-static void write_tft_data(ST7735_Config* config, const char* data, const tft_cords_t* cords,
-                           uint16_t color, uint16_t bgcolor, FontDef font);
+static void write_tft_data(ST7735_Config* config, const char* data, tft_regions region,
+                           uint16_t color, uint16_t bgcolor);
 static void GNSSDataToTFT(GNSSData_t* gnss_data, TFTElements_t* tft_elements);
 static void SoilDataToTFT(SoilData_t* soil_data, TFTElements_t* tft_elements);
+static void tft_present(TFTElements_t* tft_elements);
+static void format_value(char* buf, size_t size, const char* label, int32_t value,
+                         uint8_t decimals);
+static void soil_chart_record(const SoilData_t* soil_data);
+static void soil_chart_draw(ST7735_Config* config);
+static void soil_chart_next_metric(void);
+static void blink_icon(ST7735_Config* config, const tft_animation_t* anim);
+static void tft_on_gnss(TFTElements_t* tft_elements, const GNSSData_t* gnss_data);
+static void tft_on_soil(TFTElements_t* tft_elements, const SoilData_t* soil_data);
+static void tft_on_button(TFTElements_t* tft_elements);
+static void tft_on_power_timeout(TFTElements_t* tft_elements);
+static bool tft_wake(TFTElements_t* tft_elements);
+static void tft_page_show(TFTElements_t* tft_elements, tft_page_t page);
+static void dashboard_render(TFTElements_t* tft_elements);
+static void gnss_page_render(TFTElements_t* tft_elements);
+static void sensor_page_render(TFTElements_t* tft_elements);
+static void system_page_render(TFTElements_t* tft_elements);
+
+static const tft_page_def_t tft_pages[TFT_PAGE_COUNT] = {
+    [TFT_PAGE_DASHBOARD] = {.title = "Dashboard", .render = dashboard_render},
+    [TFT_PAGE_GNSS] = {.title = "GNSS", .render = gnss_page_render},
+    [TFT_PAGE_SENSOR] = {.title = "Soil sensor", .render = sensor_page_render},
+    [TFT_PAGE_SYSTEM] = {.title = "System", .render = system_page_render},
+};
+
+/**
+ * Parpadeo de un ícono de estado: alterna entre `color` y negro en cada cuadro de la animación.
+ */
+typedef struct
+{
+    tft_regions region;
+    const uint16_t* icon;
+    uint16_t color;
+} tft_blink_t;
+
+static const tft_blink_t gps_blink_ctx = {GPS_ICON_REGION, GPS_ICON, ST7735_RED};
+static const tft_blink_t soil_sensor_blink_ctx = {SOIL_SENSOR_ICON_REGION, SOIL_SENSOR_ICON,
+                                                  ST7735_RED};
+
+// Sin fix GNSS / sin respuesta del sensor de suelo
+static tft_animation_t gps_blink = {.draw = blink_icon, .ctx = &gps_blink_ctx, .period_ms = 100};
+static tft_animation_t soil_sensor_blink = {
+    .draw = blink_icon, .ctx = &soil_sensor_blink_ctx, .period_ms = 100};
 
 void Task_TFTDisplay(void* pvParameters)
 {
@@ -103,92 +339,321 @@ void Task_TFTDisplay(void* pvParameters)
 
     };
 
-    GNSSData_t gnss_task_data;
-    SoilData_t soil_task_data;
+    GNSSData_t gnss_task_data = {0};
+    SoilData_t soil_task_data = {0};
 
+    tft_layout_check();
     st7735_init(&tft_elements->tft_config);
+#if TFT_BENCHMARK
+    tft_benchmark_run(tft_elements);
+    // Los datos del benchmark no son lecturas reales
+    tft_model = (tft_model_t){0};
+    soil_chart.count = 0;
+    soil_chart.pending = 0;
+#endif
+#if TFT_PROFILE
+    tft_profile_init(tft_region_names, TFT_REGION_COUNT);
+#endif
     st7735_fill_screen(&tft_elements->tft_config, ST7735_BLACK);
+    tft_widgets_invalidate();
+    tft_present(tft_elements);
+    tft_power_init();
 
     // char temp_data_buffer[20];
     while (1)
     {
+        // Espera a que llegue un dato, venza el tick de animación o toque un cambio de consumo;
+        // no hay sondeo
+        QueueSetMemberHandle_t event =
+            xQueueSelectFromSet(tft_elements->events, tft_power_timeout());
 
-        // recibir de las colas
-        if (xQueueReceive(xQueueGNSSData, &gnss_task_data, 0) == pdTRUE)
+        if (event == xQueueGNSSData)
         {
-            GNSSDataToTFT(&gnss_task_data, tft_elements);
+            xQueueReceive(xQueueGNSSData, &gnss_task_data, 0);
+            tft_on_gnss(tft_elements, &gnss_task_data);
         }
-
-        if (xQueueReceive(xQueueSoilData, &soil_task_data, 0) == pdTRUE)
+        else if (event == xQueueSoilData)
+        {
+            xQueueReceive(xQueueSoilData, &soil_task_data, 0);
+            tft_on_soil(tft_elements, &soil_task_data);
+        }
+        else if (event == tft_elements->tick)
+        {
+            xSemaphoreTake(tft_elements->tick, 0);
+            // Solo se redibujan las regiones animadas
+            tft_animation_run(&tft_elements->tft_config);
+        }
+        else if (event == tft_elements->button)
+        {
+            xSemaphoreTake(tft_elements->button, 0);
+            tft_on_button(tft_elements);
+        }
+        if (!tft_power_timeout())
         {
-            SoilDataToTFT(&soil_task_data, tft_elements);
+            tft_on_power_timeout(tft_elements);
         }
-        // write_tft_data(&tft_elements->tft_config, "EXT", &tft_region_coords[MODE_REGION],
-        // ST7735_WHITE, ST7735_BLACK, Font_7x10);
+
+        // Publica las regiones modificadas en este ciclo para la tarea de envío
+        tft_present(tft_elements);
+        TFT_PROFILE_REPORT(&tft_elements->tft_config);
+        // write_tft_data(&tft_elements->tft_config, "EXT", MODE_REGION,
+        // ST7735_WHITE, ST7735_BLACK);
         //// Draw GPS icon
         //
         //// Draw Soil Sensor icon
-        // draw_icon(&tft_elements->tft_config, tft_region_coords[SOIL_SENSOR_ICON_REGION].x1,
-        // tft_region_coords[SOIL_SENSOR_ICON_REGION].y1, SOIL_SENSOR_ICON, ST7735_GREEN);
+        // draw_icon(&tft_elements->tft_config, SOIL_SENSOR_ICON_REGION, SOIL_SENSOR_ICON,
+        // ST7735_GREEN);
         //// Draw LoRa icon
-        // draw_icon(&tft_elements->tft_config, tft_region_coords[LORA_ICON_REGION].x1,
-        // tft_region_coords[LORA_ICON_REGION].y1, LORA_ICON, ST7735_CYAN);
+        // draw_icon(&tft_elements->tft_config, LORA_ICON_REGION, LORA_ICON, ST7735_CYAN);
+    }
+}
 
-        vTaskDelay(pdMS_TO_TICKS(1000)); // Delay for 1 second
+/**
+ * @brief Tarea que envía el búfer frontal del framebuffer a la pantalla TFT.
+ *
+ * Se ejecuta en el núcleo TFT_FLUSH_CORE. Espera en `flush_request` a que Task_TFTDisplay
+ * publique un cuadro, lo transmite por DMA con st7735_flush_front y libera `flush_done` para que
+ * el siguiente cuadro pueda copiarse al búfer frontal. Mientras tanto, la tarea de dibujo sigue
+ * vaciando las colas y dibujando en el búfer trasero.
+ *
+ * @param pvParameters Puntero a la estructura TFTElements_t compartida con Task_TFTDisplay.
+ */
+void Task_TFTFlush(void* pvParameters)
+{
+    TFTElements_t* tft_elements = (TFTElements_t*)pvParameters;
+
+    while (1)
+    {
+        xSemaphoreTake(tft_elements->flush_request, portMAX_DELAY);
+        st7735_flush_front(&tft_elements->tft_config);
+        xSemaphoreGive(tft_elements->flush_done);
     }
 }
 
 /**
- * @brief Dibuja un ícono en una posición específica en la pantalla.
+ * @brief Publica lo dibujado en el búfer trasero para que se envíe a la pantalla.
  *
- * Esta función toma una configuración de pantalla ST7735, coordenadas x e y, 
- * un ícono representado como un array de uint16_t y un color, y dibuja el ícono 
- * en la posición especificada en la pantalla.
+ * Con framebuffer, espera a que termine el envío anterior, copia las regiones modificadas al
+ * búfer frontal y despierta a Task_TFTFlush; la transmisión ocurre en la otra tarea. Sin
+ * framebuffer las primitivas ya escribieron en el panel y no hay nada que hacer.
  *
- * @param config Puntero a la configuración de la pantalla ST7735.
- * @param x Coordenada x donde se dibujará el ícono.
- * @param y Coordenada y donde se dibujará el ícono.
- * @param icon Puntero al array que representa el ícono a dibujar.
- * @param color Color que se usará para los píxeles del ícono.
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
  */
-// Function to draw an icon at a specific position
-static void draw_icon(ST7735_Config* config, uint16_t x, uint16_t y, const uint16_t* icon,
-                      uint16_t color)
+static void tft_present(TFTElements_t* tft_elements)
+{
+#if ST7735_USE_FRAMEBUFFER
+    xSemaphoreTake(tft_elements->flush_done, portMAX_DELAY);
+    if (st7735_swap_buffers(&tft_elements->tft_config))
+    {
+        xSemaphoreGive(tft_elements->flush_request);
+    }
+    else
+    {
+        xSemaphoreGive(tft_elements->flush_done);
+    }
+#else
+    (void)tft_elements;
+#endif
+}
+
+/**
+ * @brief Dibuja un cuadro completo del tablero con los datos GNSS y de suelo indicados.
+ *
+ * Usada por el benchmark de pantalla para medir el costo de un cuadro completo.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param gnss_data Datos GNSS a mostrar.
+ * @param soil_data Datos del sensor de suelo a mostrar.
+ */
+void tft_render_frame(TFTElements_t* tft_elements, GNSSData_t* gnss_data, SoilData_t* soil_data)
+{
+    tft_on_gnss(tft_elements, gnss_data);
+    tft_on_soil(tft_elements, soil_data);
+}
+
+/**
+ * @brief Marca todas las regiones como desactualizadas.
+ *
+ * Debe llamarse después de borrar la pantalla, para que el siguiente dibujo de cada región
+ * sea completo. El gráfico de tendencia conserva sus muestras y se vuelve a dibujar entero.
+ */
+void tft_widgets_invalidate(void)
 {
-    for (int i = 0; i < ICON_HEIGHT; i++)
+    for (int i = 0; i < TFT_REGION_COUNT; i++)
+    {
+        tft_widgets[i].valid = false;
+    }
+    soil_chart.redraw = true;
+}
+
+/**
+ * @brief Comprueba que ninguna región de `tft_layout` se superponga con otra de su misma página.
+ *
+ * Cada par superpuesto se informa en el log; la pantalla sigue funcionando, pero el texto de
+ * una región puede borrar el de la otra.
+ *
+ * @return Cantidad de pares de regiones superpuestos.
+ */
+int tft_layout_check(void)
+{
+    int overlaps = 0;
+
+    for (int a = 0; a < TFT_REGION_COUNT; a++)
     {
-        uint16_t row = icon[i];
-        for (int j = 0; j < ICON_WIDTH; j++)
+        const ST7735_Window* wa = &tft_layout[a].area;
+        for (int b = a + 1; b < TFT_REGION_COUNT; b++)
         {
-            uint16_t pixel_color = (row & (1 << (ICON_WIDTH - 1 - j)))
-                                       ? color
-                                       : 0x0000; // Use provided color for 1, Black for 0
-            // Draw the pixel at (x + j, y + i)
-            st7735_draw_pixel(config, x + j, y + i, pixel_color);
+            const ST7735_Window* wb = &tft_layout[b].area;
+            if ((tft_layout[a].pages & tft_layout[b].pages) && wa->x < wb->x + wb->w &&
+                wb->x < wa->x + wa->w && wa->y < wb->y + wb->h && wb->y < wa->y + wa->h)
+            {
+                ESP_LOGE(TAG, "Regions %d and %d overlap", a, b);
+                overlaps++;
+            }
         }
     }
+    return overlaps;
+}
+
+/**
+ * @brief Dibuja un ícono en la esquina superior izquierda de una región de la pantalla.
+ *
+ * Esta función toma una configuración de pantalla ST7735, la región, un ícono representado
+ * como un array de uint16_t y un color, y dibuja el ícono con una sola transferencia. Si la
+ * región ya muestra el mismo ícono con el mismo color, no envía nada.
+ *
+ * @param config Puntero a la configuración de la pantalla ST7735.
+ * @param region Región donde se dibujará el ícono.
+ * @param icon Puntero al array que representa el ícono a dibujar.
+ * @param color Color que se usará para los píxeles del ícono.
+ */
+static void draw_icon(ST7735_Config* config, tft_regions region, const uint16_t* icon,
+                      uint16_t color)
+{
+    tft_widget_t* widget = &tft_widgets[region];
+
+    if (widget->valid && widget->icon == icon && widget->color == color)
+        return;
+
+    TFT_PROFILE_BEGIN(config, region);
+    // Use provided color for 1, Black for 0
+    st7735_draw_bitmap_mono(config, tft_layout[region].area.x, tft_layout[region].area.y,
+                            ICON_WIDTH, ICON_HEIGHT, icon, color, ST7735_BLACK);
+    TFT_PROFILE_END(config);
+
+    *widget = (tft_widget_t){.icon = icon, .color = color, .valid = true};
+}
+
+/**
+ * @brief Dibuja un cuadro del parpadeo de un ícono de estado.
+ *
+ * @param config Puntero a la configuración de la pantalla ST7735.
+ * @param anim Animación en curso; su contexto es un tft_blink_t.
+ */
+static void blink_icon(ST7735_Config* config, const tft_animation_t* anim)
+{
+    const tft_blink_t* blink = (const tft_blink_t*)anim->ctx;
+    draw_icon(config, blink->region, blink->icon, (anim->frame & 1) ? ST7735_BLACK : blink->color);
 }
 
 /**
  * @brief Escribe datos en la pantalla TFT.
  *
  * Esta función utiliza la configuración del controlador ST7735 para escribir
- * una cadena de texto en la pantalla TFT en las coordenadas especificadas,
- * con el color de texto y de fondo proporcionados, y utilizando la fuente
- * especificada.
+ * una cadena de texto en la línea de texto de la región indicada, con el color de
+ * texto y de fondo proporcionados, y utilizando TFT_FONT.
+ *
+ * La región recuerda el último texto dibujado: solo se envían los tramos de
+ * caracteres que cambiaron, y si el texto nuevo es más corto el sobrante se
+ * borra con espacios. Un cambio de color redibuja el texto completo, y si la
+ * región no era válida se borra entera antes. El texto que no cabe en la línea
+ * de la región se descarta.
  *
  * @param config Puntero a la configuración del controlador ST7735.
  * @param data Cadena de texto a escribir en la pantalla.
- * @param cords Puntero a una estructura que contiene las coordenadas (x1, y1)
- *              donde se escribirá el texto.
+ * @param region Región donde se escribirá el texto.
  * @param color Color del texto.
  * @param bgcolor Color de fondo del texto.
- * @param font Fuente a utilizar para el texto.
  */
-static void write_tft_data(ST7735_Config* config, const char* data, const tft_cords_t* cords,
-                           uint16_t color, uint16_t bgcolor, FontDef font)
+static void write_tft_data(ST7735_Config* config, const char* data, tft_regions region,
+                           uint16_t color, uint16_t bgcolor)
+{
+    tft_widget_t* widget = &tft_widgets[region];
+    const tft_layout_t* layout = &tft_layout[region];
+    const bool restyle =
+        !widget->valid || widget->icon || widget->color != color || widget->bgcolor != bgcolor;
+
+    TFT_PROFILE_BEGIN(config, region);
+    if (!widget->valid)
+    {
+        st7735_fill_window(config, &layout->area, bgcolor);
+    }
+
+    char target[TFT_WIDGET_TEXT_MAX];
+    uint8_t length = strnlen(data, TFT_WIDGET_TEXT_MAX - 1);
+    if (length > layout->columns)
+    {
+        length = layout->columns;
+    }
+    uint8_t total = length;
+
+    memcpy(target, data, length);
+    while (widget->valid && !widget->icon && total < widget->length)
+    {
+        target[total++] = ' ';
+    }
+    target[total] = '\0';
+
+    uint8_t i = 0;
+    while (i < total)
+    {
+        if (!restyle && i < widget->length && target[i] == widget->text[i])
+        {
+            i++;
+            continue;
+        }
+
+        uint8_t end = i;
+        while (end < total &&
+               (restyle || end >= widget->length || target[end] != widget->text[end]))
+        {
+            end++;
+        }
+
+        char run[TFT_WIDGET_TEXT_MAX];
+        memcpy(run, &target[i], end - i);
+        run[end - i] = '\0';
+        st7735_write_window_text(config, &layout->text, i, run, TFT_FONT, color, bgcolor);
+        i = end;
+    }
+
+    memcpy(widget->text, data, length);
+    widget->text[length] = '\0';
+    widget->length = length;
+    widget->icon = NULL;
+    widget->color = color;
+    widget->bgcolor = bgcolor;
+    widget->valid = true;
+    TFT_PROFILE_END(config);
+}
+
+/**
+ * @brief Escribe una etiqueta seguida de un valor de punto fijo, sin usar printf.
+ *
+ * @param buf Búfer de destino.
+ * @param size Tamaño del búfer.
+ * @param label Etiqueta que antecede al valor, por ejemplo "T: ".
+ * @param value Valor escalado por 10^decimals.
+ * @param decimals Cantidad de decimales a mostrar.
+ */
+static void format_value(char* buf, size_t size, const char* label, int32_t value,
+                         uint8_t decimals)
 {
-    st7735_write_string(config, cords->x1, cords->y1, data, font, color, bgcolor);
+    numfmt_t fmt;
+
+    numfmt_init(&fmt, buf, size);
+    numfmt_str(&fmt, label);
+    numfmt_fixed(&fmt, value, decimals, 0, ' ');
 }
 
 /**
@@ -208,62 +673,62 @@ static void GNSSDataToTFT(GNSSData_t* gnss_data, TFTElements_t* tft_elements)
 
     if (gnss_data->fix_status == 1)
     {
-        draw_icon(&tft_elements->tft_config, tft_region_coords[GPS_ICON_REGION].x1,
-                  tft_region_coords[GPS_ICON_REGION].y1, GPS_ICON, ST7735_GREEN);
+        tft_animation_stop(&gps_blink);
+        draw_icon(&tft_elements->tft_config, GPS_ICON_REGION, GPS_ICON, ST7735_GREEN);
 
         // Write date
-        sprintf(temp_data_buffer, "%02d/%02d/%d ", gnss_data->day, gnss_data->month,
-                gnss_data->year);
-        write_tft_data(&tft_elements->tft_config, temp_data_buffer, &tft_region_coords[DATE_REGION],
-                       ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        numfmt_t fmt;
+        numfmt_init(&fmt, temp_data_buffer, sizeof(temp_data_buffer));
+        numfmt_int(&fmt, gnss_data->day, 2, '0');
+        numfmt_str(&fmt, "/");
+        numfmt_int(&fmt, gnss_data->month, 2, '0');
+        numfmt_str(&fmt, "/");
+        numfmt_int(&fmt, gnss_data->year, 0, ' ');
+        numfmt_str(&fmt, " ");
+        write_tft_data(&tft_elements->tft_config, temp_data_buffer, DATE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write time
-        sprintf(temp_data_buffer, "%02d:%02d    ", gnss_data->hour, gnss_data->minute);
-        write_tft_data(&tft_elements->tft_config, temp_data_buffer, &tft_region_coords[TIME_REGION],
-                       ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        numfmt_init(&fmt, temp_data_buffer, sizeof(temp_data_buffer));
+        numfmt_int(&fmt, gnss_data->hour, 2, '0');
+        numfmt_str(&fmt, ":");
+        numfmt_int(&fmt, gnss_data->minute, 2, '0');
+        numfmt_str(&fmt, "    ");
+        write_tft_data(&tft_elements->tft_config, temp_data_buffer, TIME_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write altitude
-        sprintf(temp_data_buffer, "A: %d", (uint16_t)gnss_data->altitude);
-        write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                       &tft_region_coords[ALTITUDE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        format_value(temp_data_buffer, sizeof(temp_data_buffer), "A: ",
+                     (int32_t)gnss_data->altitude, 0);
+        write_tft_data(&tft_elements->tft_config, temp_data_buffer, ALTITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write latitude
-        sprintf(temp_data_buffer, " Lt: %.6f", gnss_data->latitude);
-        write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                       &tft_region_coords[LATITUDE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        format_value(temp_data_buffer, sizeof(temp_data_buffer), "Lt: ",
+                     gnss_coord_scale(gnss_data->latitude, 6), 6);
+        write_tft_data(&tft_elements->tft_config, temp_data_buffer, LATITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write longitude
-        sprintf(temp_data_buffer, " Ln: %.5f", gnss_data->longitude);
-        write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                       &tft_region_coords[LONGITUDE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        format_value(temp_data_buffer, sizeof(temp_data_buffer), "Ln: ",
+                     gnss_coord_scale(gnss_data->longitude, 5), 5);
+        write_tft_data(&tft_elements->tft_config, temp_data_buffer, LONGITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
     }
     else
     {
-        static TickType_t last_toggle_time = 0;
-        TickType_t current_time = xTaskGetTickCount();
-        static bool toggle = false;
-
-        if ((current_time - last_toggle_time) >= pdMS_TO_TICKS(100))
-        {
-            toggle = !toggle;
-            last_toggle_time = current_time;
-        }
-
-        uint16_t color = toggle ? ST7735_RED : ST7735_BLACK;
-        draw_icon(&tft_elements->tft_config, tft_region_coords[GPS_ICON_REGION].x1,
-                  tft_region_coords[GPS_ICON_REGION].y1, GPS_ICON, color);
+        tft_animation_start(&gps_blink);
 
         // Write default date
-        write_tft_data(&tft_elements->tft_config, "00/00/00", &tft_region_coords[DATE_REGION],
-                       ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        write_tft_data(&tft_elements->tft_config, "00/00/00", DATE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write default time
-        write_tft_data(&tft_elements->tft_config, "00:00", &tft_region_coords[TIME_REGION],
-                       ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        write_tft_data(&tft_elements->tft_config, "00:00", TIME_REGION, ST7735_WHITE, ST7735_BLACK);
         // Write default altitude
-        write_tft_data(&tft_elements->tft_config, "A: 0   ", &tft_region_coords[ALTITUDE_REGION],
-                       ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        write_tft_data(&tft_elements->tft_config, "A: 0   ", ALTITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write default latitude
-        write_tft_data(&tft_elements->tft_config, "Lt: 000.00000",
-                       &tft_region_coords[LATITUDE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        write_tft_data(&tft_elements->tft_config, "Lt: 000.00000", LATITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
         // Write default longitude
-        write_tft_data(&tft_elements->tft_config, "Ln: 000.00000",
-                       &tft_region_coords[LONGITUDE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+        write_tft_data(&tft_elements->tft_config, "Ln: 000.00000", LONGITUDE_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
     }
 }
 
@@ -285,49 +750,662 @@ static void SoilDataToTFT(SoilData_t* soil_data, TFTElements_t* tft_elements)
     char temp_data_buffer[40];
     if (soil_data->status == 1)
     {
-        draw_icon(&tft_elements->tft_config, tft_region_coords[SOIL_SENSOR_ICON_REGION].x1,
-                  tft_region_coords[SOIL_SENSOR_ICON_REGION].y1, SOIL_SENSOR_ICON, ST7735_CYAN);
+        tft_animation_stop(&soil_sensor_blink);
+        draw_icon(&tft_elements->tft_config, SOIL_SENSOR_ICON_REGION, SOIL_SENSOR_ICON,
+                  ST7735_CYAN);
     }
     else
     {
-        static TickType_t last_toggle_time = 0;
-        TickType_t current_time = xTaskGetTickCount();
-        static bool toggle = false;
-
-        if ((current_time - last_toggle_time) >= pdMS_TO_TICKS(100))
-        {
-            toggle = !toggle;
-            last_toggle_time = current_time;
-        }
-
-        uint16_t color = toggle ? ST7735_RED : ST7735_BLACK;
-        draw_icon(&tft_elements->tft_config, tft_region_coords[SOIL_SENSOR_ICON_REGION].x1,
-                  tft_region_coords[SOIL_SENSOR_ICON_REGION].y1, SOIL_SENSOR_ICON, ST7735_RED);
+        tft_animation_start(&soil_sensor_blink);
     }
     // Write temperature
-    sprintf(temp_data_buffer, "T: %.1f", soil_data->temperature);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                   &tft_region_coords[TEMPERATURE_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "T: ",
+                 numfmt_scale(soil_data->temperature, 1), 1);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, TEMPERATURE_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
     // Write humidity
-    sprintf(temp_data_buffer, "H: %d", (uint8_t)soil_data->moisture);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer, &tft_region_coords[HUMIDITY_REGION],
-                   ST7735_WHITE, ST7735_BLACK, Font_7x10);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "H: ", (int32_t)soil_data->moisture,
+                 0);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, HUMIDITY_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
     // Write conductivity
-    sprintf(temp_data_buffer, "C: %d", (uint16_t)soil_data->conductivity);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                   &tft_region_coords[CONDUCTIVITY_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "C: ", soil_data->conductivity, 0);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, CONDUCTIVITY_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
     // Write pH
-    sprintf(temp_data_buffer, "pH: %.1f", soil_data->pH);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer, &tft_region_coords[PH_REGION],
-                   ST7735_WHITE, ST7735_BLACK, Font_7x10);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "pH: ", numfmt_scale(soil_data->pH, 1),
+                 1);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, PH_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
     // Write nutrients
-    sprintf(temp_data_buffer, "N: %d", soil_data->nitrogen);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer, &tft_region_coords[NITROGEN_REGION],
-                   ST7735_WHITE, ST7735_BLACK, Font_7x10);
-    sprintf(temp_data_buffer, "P: %d", soil_data->phosphorus);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                   &tft_region_coords[PHOSPHORUS_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
-    sprintf(temp_data_buffer, "K: %d", soil_data->potassium);
-    write_tft_data(&tft_elements->tft_config, temp_data_buffer,
-                   &tft_region_coords[POTASSIUM_REGION], ST7735_WHITE, ST7735_BLACK, Font_7x10);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "N: ", soil_data->nitrogen, 0);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, NITROGEN_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "P: ", soil_data->phosphorus, 0);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, PHOSPHORUS_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
+    format_value(temp_data_buffer, sizeof(temp_data_buffer), "K: ", soil_data->potassium, 0);
+    write_tft_data(&tft_elements->tft_config, temp_data_buffer, POTASSIUM_REGION, ST7735_WHITE,
+                   ST7735_BLACK);
+}
+
+/**
+ * @brief Registra un dato GNSS en el modelo y actualiza la página visible si lo muestra.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param gnss_data Dato GNSS recibido.
+ */
+static void tft_on_gnss(TFTElements_t* tft_elements, const GNSSData_t* gnss_data)
+{
+    tft_model.gnss = *gnss_data;
+    tft_model.gnss_updates++;
+
+    if (tft_power_state() == TFT_POWER_SLEEP)
+    {
+        return; // la página se pone al día al despertar
+    }
+    switch (tft_page)
+    {
+    case TFT_PAGE_DASHBOARD:
+        GNSSDataToTFT(&tft_model.gnss, tft_elements);
+        break;
+    case TFT_PAGE_GNSS:
+    case TFT_PAGE_SYSTEM: // el tiempo de funcionamiento avanza con cada dato
+        tft_pages[tft_page].render(tft_elements);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Registra una lectura del sensor de suelo en el modelo y actualiza la página visible.
+ *
+ * Las lecturas válidas se guardan además en el gráfico de tendencia, que solo se dibuja si el
+ * tablero está visible.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param soil_data Lectura recibida.
+ */
+static void tft_on_soil(TFTElements_t* tft_elements, const SoilData_t* soil_data)
+{
+    tft_model.soil = *soil_data;
+    tft_model.soil_reads++;
+
+    if (soil_data->status == 1)
+    {
+        const bool first = tft_model.soil_reads - tft_model.soil_errors == 1;
+
+        if (first || soil_data->moisture < tft_model.moisture_min)
+            tft_model.moisture_min = soil_data->moisture;
+        if (first || soil_data->moisture > tft_model.moisture_max)
+            tft_model.moisture_max = soil_data->moisture;
+        if (first || soil_data->temperature < tft_model.temperature_min)
+            tft_model.temperature_min = soil_data->temperature;
+        if (first || soil_data->temperature > tft_model.temperature_max)
+            tft_model.temperature_max = soil_data->temperature;
+        tft_model.soil_last_ok = xTaskGetTickCount();
+        soil_chart_record(soil_data);
+    }
+    else
+    {
+        tft_model.soil_errors++;
+    }
+
+    if (tft_power_state() == TFT_POWER_SLEEP)
+    {
+        return; // la página se pone al día al despertar
+    }
+    switch (tft_page)
+    {
+    case TFT_PAGE_DASHBOARD:
+        SoilDataToTFT(&tft_model.soil, tft_elements);
+        soil_chart_draw(&tft_elements->tft_config);
+        break;
+    case TFT_PAGE_SENSOR:
+        tft_pages[tft_page].render(tft_elements);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Atiende un flanco del botón de usuario.
+ *
+ * Al soltarlo, una pulsación corta pasa a la página siguiente y una larga vuelve al tablero, o,
+ * si ya está en él, cambia la métrica del gráfico de tendencia. Con TFT_PROFILE, una pulsación
+ * larga en la página del sistema vuelca el histograma de dibujo de cada región. Los flancos
+ * más cortos que TFT_BUTTON_DEBOUNCE_MS son rebotes y se ignoran. Toda pulsación cuenta como
+ * actividad; si la pantalla estaba en reposo o dormida, solo la despierta y no cambia de página.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ */
+static void tft_on_button(TFTElements_t* tft_elements)
+{
+    static TickType_t pressed_at;
+    static bool pressed;
+    static bool woke; // la pulsación en curso despertó la pantalla
+    const TickType_t now = xTaskGetTickCount();
+
+    if (user_button_pressed())
+    {
+        pressed = true;
+        pressed_at = now;
+        if (tft_wake(tft_elements))
+        {
+            woke = true;
+        }
+        return;
+    }
+    if (!pressed)
+    {
+        return;
+    }
+    pressed = false;
+
+    const TickType_t held = now - pressed_at;
+    if (held < pdMS_TO_TICKS(TFT_BUTTON_DEBOUNCE_MS))
+    {
+        return;
+    }
+    if (woke)
+    {
+        woke = false;
+        return;
+    }
+    const bool long_press = held >= pdMS_TO_TICKS(TFT_BUTTON_LONG_PRESS_MS);
+#if TFT_PROFILE
+    // En la página del sistema, la pulsación larga vuelca al log el histograma de dibujo
+    if (long_press && tft_page == TFT_PAGE_SYSTEM)
+    {
+        tft_profile_dump();
+        return;
+    }
+#endif
+    // En el tablero, la pulsación larga cambia la métrica del gráfico
+    if (long_press && tft_page == TFT_PAGE_DASHBOARD)
+    {
+        soil_chart_next_metric();
+        soil_chart_draw(&tft_elements->tft_config);
+        return;
+    }
+    tft_page_show(tft_elements,
+                  long_press ? TFT_PAGE_DASHBOARD : (tft_page + 1) % TFT_PAGE_COUNT);
+}
+
+/**
+ * @brief Reserva el panel para enviarle comandos: con framebuffer, espera a que Task_TFTFlush
+ * termine el volcado en curso, ya que ambas tareas comparten el dispositivo SPI.
+ */
+static void tft_panel_lock(TFTElements_t* tft_elements)
+{
+#if ST7735_USE_FRAMEBUFFER
+    xSemaphoreTake(tft_elements->flush_done, portMAX_DELAY);
+#else
+    (void)tft_elements;
+#endif
+}
+
+/**
+ * @brief Libera el panel reservado con tft_panel_lock.
+ */
+static void tft_panel_unlock(TFTElements_t* tft_elements)
+{
+#if ST7735_USE_FRAMEBUFFER
+    xSemaphoreGive(tft_elements->flush_done);
+#else
+    (void)tft_elements;
+#endif
+}
+
+/**
+ * @brief Pasa al siguiente estado de consumo por inactividad.
+ *
+ * Al dormir el panel se detienen las animaciones; mientras duerme no se dibuja nada.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ */
+static void tft_on_power_timeout(TFTElements_t* tft_elements)
+{
+    tft_panel_lock(tft_elements);
+    const tft_power_state_t state = tft_power_update(&tft_elements->tft_config);
+    tft_panel_unlock(tft_elements);
+
+    if (state == TFT_POWER_SLEEP)
+    {
+        tft_animation_stop(&gps_blink);
+        tft_animation_stop(&soil_sensor_blink);
+    }
+}
+
+/**
+ * @brief Registra una interacción del usuario y, si el panel dormía, pone al día la página.
+ *
+ * El controlador conserva la imagen mientras duerme y los widgets recuerdan lo que muestra, así
+ * que solo se envían las regiones que cambiaron desde que se durmió.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @return true si la pantalla estaba en reposo o dormida.
+ */
+static bool tft_wake(TFTElements_t* tft_elements)
+{
+    tft_panel_lock(tft_elements);
+    const tft_power_state_t previous = tft_power_activity(&tft_elements->tft_config);
+    tft_panel_unlock(tft_elements);
+
+    if (previous == TFT_POWER_SLEEP)
+    {
+        tft_pages[tft_page].render(tft_elements);
+    }
+    return previous != TFT_POWER_ACTIVE;
+}
+
+/**
+ * @brief Muestra una página y la dibuja completa desde el modelo.
+ *
+ * Al dejar el tablero se detienen sus animaciones. Toda página se dibuja sobre la pantalla
+ * borrada; el gráfico de tendencia se redibuja desde su anillo, que siguió guardando muestras
+ * mientras el tablero estaba oculto, así que no hace falta guardar una copia de los píxeles.
+ *
+ * @param tft_elements Puntero a la estructura que contiene la configuración del TFT.
+ * @param page Página a mostrar.
+ */
+static void tft_page_show(TFTElements_t* tft_elements, tft_page_t page)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+
+    if (page == tft_page)
+    {
+        return;
+    }
+
+    if (tft_page == TFT_PAGE_DASHBOARD)
+    {
+        // Los íconos de estado solo parpadean en el tablero
+        tft_animation_stop(&gps_blink);
+        tft_animation_stop(&soil_sensor_blink);
+    }
+    tft_page = page;
+
+    st7735_fill_screen(config, ST7735_BLACK);
+    tft_widgets_invalidate();
+    tft_pages[page].render(tft_elements);
+}
+
+/**
+ * @brief Escribe el título de una página de detalle con su posición, por ejemplo "2/4 GNSS".
+ */
+static void page_title(ST7735_Config* config, tft_page_t page)
+{
+    char text[TFT_WIDGET_TEXT_MAX];
+    numfmt_t fmt;
+
+    numfmt_init(&fmt, text, sizeof(text));
+    numfmt_int(&fmt, page + 1, 0, ' ');
+    numfmt_str(&fmt, "/");
+    numfmt_int(&fmt, TFT_PAGE_COUNT, 0, ' ');
+    numfmt_str(&fmt, " ");
+    numfmt_str(&fmt, tft_pages[page].title);
+    write_tft_data(config, text, PAGE_TITLE_REGION, ST7735_YELLOW, ST7735_BLACK);
+}
+
+/**
+ * @brief Dibuja el tablero: datos GNSS, datos de suelo y gráfico de tendencia.
+ *
+ * Las partes sin datos todavía se dejan en blanco, igual que al arrancar.
+ */
+static void dashboard_render(TFTElements_t* tft_elements)
+{
+    if (tft_model.gnss_updates)
+    {
+        GNSSDataToTFT(&tft_model.gnss, tft_elements);
+    }
+    if (tft_model.soil_reads)
+    {
+        SoilDataToTFT(&tft_model.soil, tft_elements);
+    }
+    soil_chart_draw(&tft_elements->tft_config);
+}
+
+/**
+ * @brief Dibuja la página de detalle GNSS: fijación, satélites, HDOP, posición y hora.
+ */
+static void gnss_page_render(TFTElements_t* tft_elements)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+    const GNSSData_t* gnss = &tft_model.gnss;
+    const bool fix = gnss->fix_status == 1;
+    char text[TFT_WIDGET_TEXT_MAX];
+    numfmt_t fmt;
+
+    page_title(config, TFT_PAGE_GNSS);
+    write_tft_data(config, fix ? "Fix: yes" : "Fix: no", GNSS_FIX_REGION,
+                   fix ? ST7735_GREEN : ST7735_RED, ST7735_BLACK);
+    format_value(text, sizeof(text), "Sats: ", gnss->satellites_used, 0);
+    write_tft_data(config, text, GNSS_SATS_REGION, ST7735_WHITE, ST7735_BLACK);
+    format_value(text, sizeof(text), "HDOP: ", numfmt_scale(gnss->hdop, 1), 1);
+    write_tft_data(config, text, GNSS_HDOP_REGION, ST7735_WHITE, ST7735_BLACK);
+    format_value(text, sizeof(text), "Alt: ", (int32_t)gnss->altitude, 0);
+    write_tft_data(config, text, GNSS_ALTITUDE_REGION, ST7735_WHITE, ST7735_BLACK);
+    format_value(text, sizeof(text), "Lat: ", gnss_coord_scale(gnss->latitude, 6), 6);
+    write_tft_data(config, text, GNSS_LATITUDE_REGION, ST7735_WHITE, ST7735_BLACK);
+    format_value(text, sizeof(text), "Lon: ", gnss_coord_scale(gnss->longitude, 6), 6);
+    write_tft_data(config, text, GNSS_LONGITUDE_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    numfmt_init(&fmt, text, sizeof(text));
+    numfmt_int(&fmt, gnss->day, 2, '0');
+    numfmt_str(&fmt, "/");
+    numfmt_int(&fmt, gnss->month, 2, '0');
+    numfmt_str(&fmt, "/");
+    numfmt_int(&fmt, gnss->year, 2, '0');
+    numfmt_str(&fmt, " ");
+    numfmt_int(&fmt, gnss->hour, 2, '0');
+    numfmt_str(&fmt, ":");
+    numfmt_int(&fmt, gnss->minute, 2, '0');
+    write_tft_data(config, text, GNSS_TIME_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    format_value(text, sizeof(text), "Updates: ", (int32_t)tft_model.gnss_updates, 0);
+    write_tft_data(config, text, GNSS_UPDATES_REGION, ST7735_GRAY, ST7735_BLACK);
+}
+
+/**
+ * @brief Escribe el rango de una métrica, por ejemplo "H: 12.0 - 80.0 %".
+ */
+static void format_range(char* buf, size_t size, const char* label, float min, float max,
+                         const char* unit)
+{
+    numfmt_t fmt;
+
+    numfmt_init(&fmt, buf, size);
+    numfmt_str(&fmt, label);
+    numfmt_fixed(&fmt, numfmt_scale(min, 1), 1, 0, ' ');
+    numfmt_str(&fmt, " - ");
+    numfmt_fixed(&fmt, numfmt_scale(max, 1), 1, 0, ' ');
+    numfmt_str(&fmt, unit);
+}
+
+/**
+ * @brief Dibuja la página de salud del sensor de suelo: estado, lecturas, errores y rangos.
+ */
+static void sensor_page_render(TFTElements_t* tft_elements)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+    const uint32_t valid = tft_model.soil_reads - tft_model.soil_errors;
+    char text[TFT_WIDGET_TEXT_MAX];
+    numfmt_t fmt;
+
+    page_title(config, TFT_PAGE_SENSOR);
+
+    if (!tft_model.soil_reads)
+        write_tft_data(config, "Status: waiting", SENSOR_STATUS_REGION, ST7735_GRAY, ST7735_BLACK);
+    else if (tft_model.soil.status == 1)
+        write_tft_data(config, "Status: OK", SENSOR_STATUS_REGION, ST7735_GREEN, ST7735_BLACK);
+    else
+        write_tft_data(config, "Status: no reply", SENSOR_STATUS_REGION, ST7735_RED, ST7735_BLACK);
+
+    format_value(text, sizeof(text), "Reads: ", (int32_t)tft_model.soil_reads, 0);
+    write_tft_data(config, text, SENSOR_READS_REGION, ST7735_WHITE, ST7735_BLACK);
+    format_value(text, sizeof(text), "Errors: ", (int32_t)tft_model.soil_errors, 0);
+    write_tft_data(config, text, SENSOR_ERRORS_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    // Porcentaje de lecturas válidas, con un decimal
+    numfmt_init(&fmt, text, sizeof(text));
+    numfmt_str(&fmt, "Success: ");
+    numfmt_fixed(&fmt,
+                 tft_model.soil_reads ? (int32_t)((uint64_t)valid * 1000 / tft_model.soil_reads)
+                                      : 0,
+                 1, 0, ' ');
+    numfmt_str(&fmt, " %");
+    write_tft_data(config, text, SENSOR_SUCCESS_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    if (valid)
+    {
+        format_range(text, sizeof(text), "H: ", tft_model.moisture_min, tft_model.moisture_max,
+                     " %");
+        write_tft_data(config, text, SENSOR_MOISTURE_REGION, ST7735_CYAN, ST7735_BLACK);
+        format_range(text, sizeof(text), "T: ", tft_model.temperature_min,
+                     tft_model.temperature_max, " C");
+        write_tft_data(config, text, SENSOR_TEMPERATURE_REGION, ST7735_ORANGE, ST7735_BLACK);
+
+        const TickType_t age = xTaskGetTickCount() - tft_model.soil_last_ok;
+        format_value(text, sizeof(text), "Last OK: ", (int32_t)(age / configTICK_RATE_HZ), 0);
+        numfmt_init(&fmt, text + strlen(text), sizeof(text) - strlen(text));
+        numfmt_str(&fmt, " s ago");
+        write_tft_data(config, text, SENSOR_LAST_OK_REGION, ST7735_WHITE, ST7735_BLACK);
+    }
+    else
+    {
+        write_tft_data(config, "H: --", SENSOR_MOISTURE_REGION, ST7735_CYAN, ST7735_BLACK);
+        write_tft_data(config, "T: --", SENSOR_TEMPERATURE_REGION, ST7735_ORANGE, ST7735_BLACK);
+        write_tft_data(config, "Last OK: never", SENSOR_LAST_OK_REGION, ST7735_WHITE,
+                       ST7735_BLACK);
+    }
+}
+
+/**
+ * @brief Dibuja la página del sistema: enlace LoRa, almacenamiento, tiempo encendido, memoria
+ * libre, tráfico enviado a la pantalla y duración del último despertar del panel.
+ *
+ * La placa todavía no tiene controladores de LoRa ni de tarjeta SD, así que esas líneas solo
+ * indican que no están disponibles.
+ */
+static void system_page_render(TFTElements_t* tft_elements)
+{
+    ST7735_Config* config = &tft_elements->tft_config;
+    const uint32_t uptime = (uint32_t)(esp_timer_get_time() / 1000000);
+    char text[TFT_WIDGET_TEXT_MAX];
+    numfmt_t fmt;
+
+    page_title(config, TFT_PAGE_SYSTEM);
+    write_tft_data(config, "LoRa: not available", SYSTEM_LORA_REGION, ST7735_GRAY, ST7735_BLACK);
+    write_tft_data(config, "SD: not available", SYSTEM_STORAGE_REGION, ST7735_GRAY,
+                   ST7735_BLACK);
+
+    numfmt_init(&fmt, text, sizeof(text));
+    numfmt_str(&fmt, "Up: ");
+    numfmt_int(&fmt, uptime / 3600, 2, '0');
+    numfmt_str(&fmt, ":");
+    numfmt_int(&fmt, uptime / 60 % 60, 2, '0');
+    numfmt_str(&fmt, ":");
+    numfmt_int(&fmt, uptime % 60, 2, '0');
+    write_tft_data(config, text, SYSTEM_UPTIME_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    format_value(text, sizeof(text), "Heap: ", (int32_t)esp_get_free_heap_size(), 0);
+    write_tft_data(config, text, SYSTEM_HEAP_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    format_value(text, sizeof(text), "TFT: ", (int32_t)(st7735_get_stats(config).bytes / 1024),
+                 0);
+    numfmt_init(&fmt, text + strlen(text), sizeof(text) - strlen(text));
+    numfmt_str(&fmt, " kB sent");
+    write_tft_data(config, text, SYSTEM_TFT_REGION, ST7735_WHITE, ST7735_BLACK);
+
+    // Lo que tardó el último despertar del panel
+    if (tft_power_wake_us())
+    {
+        format_value(text, sizeof(text), "Wake: ", (int32_t)(tft_power_wake_us() / 100), 1);
+        numfmt_init(&fmt, text + strlen(text), sizeof(text) - strlen(text));
+        numfmt_str(&fmt, " ms");
+        write_tft_data(config, text, SYSTEM_WAKE_REGION, ST7735_WHITE, ST7735_BLACK);
+    }
+    else
+    {
+        write_tft_data(config, "Wake: --", SYSTEM_WAKE_REGION, ST7735_WHITE, ST7735_BLACK);
+    }
+}
+
+/**
+ * @brief Obtiene el valor de una métrica a partir de una lectura del sensor de suelo.
+ */
+static float soil_metric_value(const SoilData_t* soil_data, soil_metric_t metric)
+{
+    switch (metric)
+    {
+    case SOIL_METRIC_MOISTURE:
+        return soil_data->moisture;
+    case SOIL_METRIC_TEMPERATURE:
+        return soil_data->temperature;
+    case SOIL_METRIC_CONDUCTIVITY:
+        return soil_data->conductivity;
+    case SOIL_METRIC_PH:
+        return soil_data->pH;
+    case SOIL_METRIC_NITROGEN:
+        return soil_data->nitrogen;
+    case SOIL_METRIC_PHOSPHORUS:
+        return soil_data->phosphorus;
+    case SOIL_METRIC_POTASSIUM:
+        return soil_data->potassium;
+    default:
+        return 0.0f;
+    }
+}
+
+/**
+ * @brief Convierte un valor en la fila del gráfico (0 arriba) según la escala de la métrica.
+ */
+static uint8_t soil_chart_row(soil_metric_t metric, float value)
+{
+    const soil_metric_scale_t* scale = &soil_metric_scales[metric];
+
+    if (value <= scale->min)
+        return SOIL_CHART_HEIGHT - 1;
+    if (value >= scale->max)
+        return 0;
+    return (SOIL_CHART_HEIGHT - 1) -
+           (uint8_t)((value - scale->min) * (SOIL_CHART_HEIGHT - 1) / (scale->max - scale->min));
+}
+
+/**
+ * @brief Dibuja la columna de una muestra del gráfico.
+ *
+ * La columna une la fila de la muestra con la de la muestra anterior, si existe, para que la
+ * curva se vea continua aunque el valor cambie mucho entre lecturas. Se envía como un mapa de
+ * bits de un píxel de ancho, en una sola ventana.
+ *
+ * @param config Puntero a la configuración de la pantalla ST7735.
+ * @param column Columna del gráfico (posición en el anillo).
+ * @param has_previous true si la columna anterior contiene la muestra previa.
+ */
+static void soil_chart_draw_column(ST7735_Config* config, uint8_t column, bool has_previous)
+{
+    uint16_t bitmap[SOIL_CHART_HEIGHT] = {0};
+    const float* samples = soil_chart.samples[soil_chart.metric];
+    uint8_t row = soil_chart_row(soil_chart.metric, samples[column]);
+    uint8_t from = row;
+    uint8_t to = row;
+
+    if (has_previous)
+    {
+        uint8_t prev = (column + SOIL_CHART_WIDTH - 1) % SOIL_CHART_WIDTH;
+        uint8_t prev_row = soil_chart_row(soil_chart.metric, samples[prev]);
+        // Cubre el salto hasta la fila anterior, que ya está dibujada en su propia columna
+        if (prev_row < row)
+            from = prev_row + 1;
+        else if (prev_row > row)
+            to = prev_row - 1;
+    }
+    for (uint8_t y = from; y <= to; y++)
+    {
+        bitmap[y] = 1;
+    }
+
+    st7735_draw_bitmap_mono(config, SOIL_CHART_X + column, SOIL_CHART_Y, 1, SOIL_CHART_HEIGHT,
+                            bitmap, soil_metric_scales[soil_chart.metric].color, ST7735_BLACK);
+}
+
+/**
+ * @brief Guarda una lectura en el anillo del gráfico de tendencia, sin dibujarla.
+ *
+ * @param soil_data Lectura válida del sensor de suelo.
+ */
+static void soil_chart_record(const SoilData_t* soil_data)
+{
+    soil_chart.head = (soil_chart.head + 1) % SOIL_CHART_WIDTH;
+    for (soil_metric_t metric = 0; metric < SOIL_METRIC_COUNT; metric++)
+    {
+        soil_chart.samples[metric][soil_chart.head] = soil_metric_value(soil_data, metric);
+    }
+    if (soil_chart.count < SOIL_CHART_WIDTH)
+    {
+        soil_chart.count++;
+    }
+    if (soil_chart.pending < SOIL_CHART_WIDTH)
+    {
+        soil_chart.pending++;
+    }
+}
+
+/**
+ * @brief Dibuja el gráfico completo desde el anillo, de la muestra más antigua a la más nueva.
+ *
+ * @param config Puntero a la configuración de la pantalla ST7735.
+ */
+static void soil_chart_redraw(ST7735_Config* config)
+{
+    const uint8_t oldest = (soil_chart.head + SOIL_CHART_WIDTH + 1 - soil_chart.count) %
+                           SOIL_CHART_WIDTH;
+
+    st7735_fill_window(config, &tft_layout[SOIL_CHART_REGION].area, ST7735_BLACK);
+    // Con el anillo lleno, la columna de la muestra más antigua es el cursor y queda vacía
+    for (uint8_t i = soil_chart.count == SOIL_CHART_WIDTH ? 1 : 0; i < soil_chart.count; i++)
+    {
+        soil_chart_draw_column(config, (oldest + i) % SOIL_CHART_WIDTH, i > 0);
+    }
+
+    soil_chart.pending = 0;
+    soil_chart.redraw = false;
+}
+
+/**
+ * @brief Pasa el gráfico de tendencia a la métrica siguiente.
+ *
+ * Todas las métricas guardan sus muestras en el anillo, así que la nueva se muestra con la
+ * misma historia; el gráfico se marca para dibujarse completo con su escala y su color.
+ */
+static void soil_chart_next_metric(void)
+{
+    soil_chart.metric = (soil_chart.metric + 1) % SOIL_METRIC_COUNT;
+    soil_chart.redraw = true;
+}
+
+/**
+ * @brief Dibuja las muestras del gráfico de tendencia que todavía no están en pantalla.
+ *
+ * Por cada muestra nueva se dibujan solo dos columnas: la de la muestra y, una vez lleno el
+ * anillo, la siguiente, que se borra porque contenía la muestra más antigua. El costo por
+ * muestra no depende del tamaño del gráfico. Si la pantalla perdió el gráfico, o todas sus
+ * columnas cambiaron mientras el tablero estaba oculto, se dibuja completo.
+ *
+ * @param config Puntero a la configuración de la pantalla ST7735.
+ */
+static void soil_chart_draw(ST7735_Config* config)
+{
+    if (!soil_chart.redraw && !soil_chart.pending)
+    {
+        return;
+    }
+
+    TFT_PROFILE_BEGIN(config, SOIL_CHART_REGION);
+    if (soil_chart.redraw || soil_chart.pending >= SOIL_CHART_WIDTH)
+    {
+        soil_chart_redraw(config);
+    }
+    else
+    {
+        for (uint8_t k = soil_chart.pending; k > 0; k--)
+        {
+            const uint8_t column =
+                (soil_chart.head + SOIL_CHART_WIDTH + 1 - k) % SOIL_CHART_WIDTH;
+
+            soil_chart_draw_column(config, column, soil_chart.count > k);
+            if (soil_chart.count == SOIL_CHART_WIDTH)
+            {
+                uint8_t oldest = (column + 1) % SOIL_CHART_WIDTH;
+                st7735_fill_rectangle(config, SOIL_CHART_X + oldest, SOIL_CHART_Y, 1,
+                                      SOIL_CHART_HEIGHT, ST7735_BLACK);
+            }
+        }
+        soil_chart.pending = 0;
+    }
+    TFT_PROFILE_END(config);
 }
@@ -0,0 +1,108 @@
+#include "tft_power.h"
+#include "backlight_handler.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "logger.h"
+
+static const char* TAG = "[TFT_POWER]";
+
+static tft_power_state_t power_state;
+static TickType_t last_activity;
+static uint32_t wake_us;
+
+/**
+ * @brief Ajusta el brillo de la luz de fondo.
+ *
+ * Si el PWM no pudo inicializarse, el pin sigue siendo un GPIO: se enciende o apaga por
+ * completo, para que el panel nunca quede en reposo con la luz encendida.
+ *
+ * @param percent Brillo de 0 (apagada) a 100.
+ */
+static void tft_power_backlight(uint8_t percent)
+{
+    if (tft_backlight_set(percent) != ESP_OK)
+    {
+        gpio_set_level(TFT_LED_K_Pin, percent ? 1 : 0);
+    }
+}
+
+void tft_power_init(void)
+{
+    power_state = TFT_POWER_ACTIVE;
+    last_activity = xTaskGetTickCount();
+    tft_power_backlight(TFT_BACKLIGHT_ACTIVE);
+}
+
+TickType_t tft_power_timeout(void)
+{
+    TickType_t limit;
+
+    switch (power_state)
+    {
+    case TFT_POWER_ACTIVE:
+        limit = pdMS_TO_TICKS(TFT_POWER_IDLE_S * 1000);
+        break;
+    case TFT_POWER_IDLE:
+        limit = pdMS_TO_TICKS(TFT_POWER_SLEEP_S * 1000);
+        break;
+    default:
+        return portMAX_DELAY;
+    }
+
+    const TickType_t elapsed = xTaskGetTickCount() - last_activity;
+    return elapsed >= limit ? 0 : limit - elapsed;
+}
+
+tft_power_state_t tft_power_update(ST7735_Config* config)
+{
+    if (tft_power_timeout())
+    {
+        return power_state;
+    }
+
+    if (power_state == TFT_POWER_ACTIVE)
+    {
+        st7735_idle_mode(config, true);
+        tft_power_backlight(TFT_BACKLIGHT_IDLE);
+        power_state = TFT_POWER_IDLE;
+    }
+    else
+    {
+        // La luz se apaga antes para que no se vea el panel en blanco
+        tft_power_backlight(0);
+        st7735_sleep(config);
+        power_state = TFT_POWER_SLEEP;
+    }
+    return power_state;
+}
+
+tft_power_state_t tft_power_activity(ST7735_Config* config)
+{
+    const tft_power_state_t previous = power_state;
+
+    last_activity = xTaskGetTickCount();
+
+    if (previous == TFT_POWER_SLEEP)
+    {
+        const int64_t start = esp_timer_get_time();
+
+        st7735_wake(config);
+        st7735_idle_mode(config, false);
+        tft_power_backlight(TFT_BACKLIGHT_ACTIVE);
+
+        wake_us = (uint32_t)(esp_timer_get_time() - start);
+        ESP_LOGI(TAG, "Panel awake in %lu us", (unsigned long)wake_us);
+    }
+    else if (previous == TFT_POWER_IDLE)
+    {
+        st7735_idle_mode(config, false);
+        tft_power_backlight(TFT_BACKLIGHT_ACTIVE);
+    }
+    power_state = TFT_POWER_ACTIVE;
+
+    return previous;
+}
+
+tft_power_state_t tft_power_state(void) { return power_state; }
+
+uint32_t tft_power_wake_us(void) { return wake_us; }
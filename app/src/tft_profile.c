@@ -0,0 +1,221 @@
+#include "tft_profile.h"
+#include "esp_timer.h"
+#include "logger.h"
+#include <stdio.h>
+#include <string.h>
+
+// Regiones más costosas que se muestran en la línea de resumen
+#define TFT_PROFILE_TOP 3
+
+static const char* TAG = "[TFT_PROFILE]";
+
+typedef struct
+{
+    uint32_t draws;        // dibujos en el periodo
+    uint32_t bytes;        // bytes SPI (o pendientes de volcar) en el periodo
+    uint32_t transactions; // transacciones SPI (o rectángulos sucios) en el periodo
+    uint32_t us;           // microsegundos dibujando en el periodo
+    uint32_t hist[TFT_PROFILE_HIST_BUCKETS]; // dibujos por duración, desde el último volcado
+} tft_profile_region_t;
+
+static tft_profile_region_t regions[TFT_PROFILE_MAX_REGIONS];
+static const char* const* region_names;
+static uint8_t region_count;
+
+// Medición en curso
+static uint8_t current_region;
+static bool measuring;
+static int64_t start_us;
+static ST7735_Stats start_stats;
+
+// Periodo de la línea de resumen
+static int64_t period_start_us;
+static uint32_t period_start_bytes;
+
+/**
+ * @brief Bytes y transacciones que generó el dibujo hasta ahora, según el modo del controlador.
+ */
+static void tft_profile_sample(const ST7735_Stats* stats, uint32_t* bytes, uint32_t* transactions)
+{
+#if ST7735_USE_FRAMEBUFFER
+    // El volcado corre en otra tarea y también suma a `bytes`; lo dibujado se mide por lo que
+    // quedó pendiente
+    *bytes = stats->pixels * sizeof(uint16_t);
+    *transactions = stats->rects;
+#else
+    *bytes = stats->bytes;
+    *transactions = stats->transactions;
+#endif
+}
+
+/**
+ * @brief Intervalo del histograma que corresponde a una duración.
+ */
+static uint8_t tft_profile_bucket(uint32_t us)
+{
+    uint8_t bucket = 0;
+    uint32_t limit = TFT_PROFILE_HIST_FIRST_US;
+
+    while (us >= limit && bucket < TFT_PROFILE_HIST_BUCKETS - 1)
+    {
+        limit <<= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void tft_profile_init(const char* const* names, uint8_t count)
+{
+    if (count > TFT_PROFILE_MAX_REGIONS)
+    {
+        ESP_LOGE(TAG, "Too many regions: %u, only %u are measured", count,
+                 TFT_PROFILE_MAX_REGIONS);
+        count = TFT_PROFILE_MAX_REGIONS;
+    }
+
+    memset(regions, 0, sizeof(regions));
+    region_names = names;
+    region_count = count;
+    measuring = false;
+    period_start_us = esp_timer_get_time();
+    period_start_bytes = 0;
+}
+
+void tft_profile_begin(const ST7735_Config* config, uint8_t region)
+{
+    if (region >= region_count)
+    {
+        return;
+    }
+
+    current_region = region;
+    measuring = true;
+    start_stats = st7735_get_stats(config);
+    start_us = esp_timer_get_time();
+}
+
+void tft_profile_end(const ST7735_Config* config)
+{
+    if (!measuring)
+    {
+        return;
+    }
+
+    const uint32_t us = (uint32_t)(esp_timer_get_time() - start_us);
+    const ST7735_Stats stats = st7735_get_stats(config);
+    uint32_t bytes, transactions, start_bytes, start_transactions;
+    tft_profile_region_t* r = &regions[current_region];
+
+    tft_profile_sample(&stats, &bytes, &transactions);
+    tft_profile_sample(&start_stats, &start_bytes, &start_transactions);
+    measuring = false;
+
+    r->draws++;
+    r->bytes += bytes - start_bytes;
+    r->transactions += transactions - start_transactions;
+    r->us += us;
+    r->hist[tft_profile_bucket(us)]++;
+}
+
+void tft_profile_report(const ST7735_Config* config)
+{
+    const int64_t now = esp_timer_get_time();
+    if (now - period_start_us < (int64_t)TFT_PROFILE_PERIOD_MS * 1000)
+    {
+        return;
+    }
+
+    uint32_t draws = 0, bytes = 0, transactions = 0, us = 0;
+    uint8_t top[TFT_PROFILE_TOP];
+    uint8_t top_count = 0;
+
+    for (uint8_t i = 0; i < region_count; i++)
+    {
+        const tft_profile_region_t* r = &regions[i];
+        if (!r->draws)
+        {
+            continue;
+        }
+        draws += r->draws;
+        bytes += r->bytes;
+        transactions += r->transactions;
+        us += r->us;
+
+        // Inserción ordenada por tiempo en la lista de las más costosas
+        uint8_t pos = top_count;
+        while (pos > 0 && regions[top[pos - 1]].us < r->us)
+        {
+            if (pos < TFT_PROFILE_TOP)
+            {
+                top[pos] = top[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < TFT_PROFILE_TOP)
+        {
+            top[pos] = i;
+            if (top_count < TFT_PROFILE_TOP)
+            {
+                top_count++;
+            }
+        }
+    }
+
+    const uint32_t spi_bytes = st7735_get_stats(config).bytes;
+    char line[TFT_PROFILE_TOP * 64];
+    int len = 0;
+    for (uint8_t i = 0; i < top_count && len < (int)sizeof(line); i++)
+    {
+        const tft_profile_region_t* r = &regions[top[i]];
+        len += snprintf(line + len, sizeof(line) - len, " | %s %lu us %lu B",
+                        region_names[top[i]], (unsigned long)r->us, (unsigned long)r->bytes);
+    }
+
+    ESP_LOGI(TAG, "%lu s: %lu draws, %lu us, %lu B, %lu tx, SPI %lu B%s",
+             (unsigned long)((now - period_start_us) / 1000000), (unsigned long)draws,
+             (unsigned long)us, (unsigned long)bytes, (unsigned long)transactions,
+             (unsigned long)(spi_bytes - period_start_bytes), top_count ? line : "");
+
+    for (uint8_t i = 0; i < region_count; i++)
+    {
+        regions[i].draws = 0;
+        regions[i].bytes = 0;
+        regions[i].transactions = 0;
+        regions[i].us = 0;
+    }
+    period_start_us = now;
+    period_start_bytes = spi_bytes;
+}
+
+void tft_profile_dump(void)
+{
+    char line[TFT_PROFILE_HIST_BUCKETS * 12];
+    int len = 0;
+    uint32_t limit = TFT_PROFILE_HIST_FIRST_US;
+
+    for (uint8_t b = 0; b < TFT_PROFILE_HIST_BUCKETS - 1; b++, limit <<= 1)
+    {
+        len += snprintf(line + len, sizeof(line) - len, " <%-6lu", (unsigned long)limit);
+    }
+    snprintf(line + len, sizeof(line) - len, " >=%-5lu", (unsigned long)(limit >> 1));
+    // Los contadores van primero para que las columnas queden alineadas con la cabecera
+    ESP_LOGI(TAG, "%s  draw time (us)", line);
+
+    for (uint8_t i = 0; i < region_count; i++)
+    {
+        tft_profile_region_t* r = &regions[i];
+        uint32_t total = 0;
+
+        len = 0;
+        for (uint8_t b = 0; b < TFT_PROFILE_HIST_BUCKETS; b++)
+        {
+            total += r->hist[b];
+            len += snprintf(line + len, sizeof(line) - len, " %7lu", (unsigned long)r->hist[b]);
+        }
+        if (total)
+        {
+            ESP_LOGI(TAG, "%s  %s", line, region_names[i]);
+        }
+        memset(r->hist, 0, sizeof(r->hist));
+    }
+}
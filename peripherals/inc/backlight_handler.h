@@ -0,0 +1,44 @@
+/**
+ * @file backlight_handler.h
+ * @brief Header file for the TFT backlight handler.
+ *
+ * The backlight LED (TFT_LED_K_Pin) is driven by an LEDC PWM channel, so its brightness can be
+ * lowered or switched off to save battery. Until init_tft_backlight succeeds the pin stays a
+ * plain GPIO, fully on as left by tft_spi_init.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef BACKLIGHT_HANDLER_H
+#define BACKLIGHT_HANDLER_H
+
+#include "config.h"
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Configures the LEDC timer and channel of the backlight and turns it fully on.
+     *
+     * @return ESP_OK on success, or the error of the LEDC driver call that failed.
+     */
+    esp_err_t init_tft_backlight(void);
+
+    /**
+     * @brief Sets the backlight brightness.
+     *
+     * @param percent Brightness from 0 (off) to 100 (fully on); larger values are clamped.
+     * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the backlight was not initialized.
+     */
+    esp_err_t tft_backlight_set(uint8_t percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BACKLIGHT_HANDLER_H */
@@ -0,0 +1,46 @@
+/**
+ * @file button_handler.h
+ * @brief Header file for the user button handler.
+ *
+ * The user button (USER_BUTTON_Pin) is read with a GPIO interrupt on both edges. The interrupt
+ * only gives a semaphore, so the task waiting on it decides what a press means and does the
+ * debouncing; nothing is polled.
+ *
+ * @author Leandro Quiroga
+ * @date nov 2024
+ */
+
+#ifndef BUTTON_HANDLER_H
+#define BUTTON_HANDLER_H
+
+#include "config.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Configures the user button as an input with pull-up and an interrupt on both edges.
+     *
+     * @param event Binary semaphore given from the interrupt on every press and release.
+     * @return ESP_OK on success, or the error of the GPIO driver call that failed.
+     */
+    esp_err_t init_user_button(SemaphoreHandle_t event);
+
+    /**
+     * @brief Reads the current state of the user button.
+     *
+     * @return true while the button is held down.
+     */
+    bool user_button_pressed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUTTON_HANDLER_H */
@@ -7,6 +7,8 @@
 #define GNSS_RX_PIN 33       ///< Mandatory GPIO pin number for GNSS RX by Heltec.
 #define GNSS_TX_PIN 34       ///< Mandatory GPIO pin number for GNSS TX by Heltec.
 #define GNSS_UART_BUF_SIZE 2000
+#define GNSS_UART_EVENT_QUEUE_SIZE 32   ///< UART driver events pending for the GNSS task.
+#define GNSS_UART_PATTERN_QUEUE_SIZE 32 ///< Line ends pending (~25 NMEA lines per epoch).
 
 
 /* GNSS uart config. These parameters are mandatory por heltec board*/
@@ -27,5 +29,9 @@
 #define TFT_SCLK_Pin 41
 #define TFT_MOSI_Pin 42
 #define TFT_LED_K_Pin 21
+#define TFT_BACKLIGHT_PWM_FREQ 5000 // Hz, above visible flicker
+
+/* User button (PRG) of the Heltec board, active low */
+#define USER_BUTTON_Pin 0
 
 #endif /* CONFIG_H_ */
\ No newline at end of file
@@ -24,12 +24,42 @@ extern "C"
     /**
      * @brief Initializes the GNSS UART.
      *
-     * This function sets up the UART configuration for GNSS communication.
+     * This function sets up the UART configuration for GNSS communication, with an event queue
+     * (uart_t::data_queue) that reports each received line through pattern detection on '\n'.
      *
-     * @return uart_t The initialized UART configuration for GNSS.
+     * @return uart_t The initialized UART configuration for GNSS; uart_num is UART_NUM_MAX if
+     *         the driver could not be installed.
      */
     uart_t init_gnss_uart();
 
+    /**
+     * @brief Returns how many bytes to read to reach the end of the next detected line.
+     *
+     * Call it on each UART_PATTERN_DET event.
+     *
+     * @param uart GNSS UART.
+     * @return Bytes up to and including the '\n', or every buffered byte if no line end is
+     *         recorded.
+     */
+    int gnss_uart_line_length(uart_t* uart);
+
+    /**
+     * @brief Returns how many bytes to read to reach the end of the next detected line.
+     *
+     * Call it after reading each line to drain the other complete lines already buffered.
+     *
+     * @param uart GNSS UART.
+     * @return Bytes up to and including the '\n', or 0 if no line end is recorded.
+     */
+    int gnss_uart_next_line_length(uart_t* uart);
+
+    /**
+     * @brief Discards the received data and pending events after an RX overflow.
+     *
+     * @param uart GNSS UART.
+     */
+    void gnss_uart_reset_input(uart_t* uart);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,7 +69,8 @@
  * @brief Initializes the TFT SPI configuration.
  *
  * This function initializes the TFT SPI configuration and returns a tft_config_t structure
- * with the configured parameters.
+ * with the configured parameters. The SPI device is registered with a pre-transfer callback
+ * that sets the DC pin from each transaction's `user` field (0 = command, 1 = data).
  *
  * @return tft_config_t structure with the initialized configuration.
  */
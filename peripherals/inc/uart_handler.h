@@ -17,7 +17,7 @@ typedef struct
     bool has_peek;            // Indica si se ha hecho un "peek"
     uint8_t peek_byte;        // El byte "peeked"
     size_t buffered_size;     // Tamaño del buffer
-    QueueHandle_t data_queue; // Cola para almacenar datos leídos
+    QueueHandle_t data_queue; // Cola del puerto (en el GNSS, los eventos del controlador UART)
 } uart_t;
 
 #endif /* UART_HANDLER_H */
@@ -0,0 +1,78 @@
+/**
+ * @file backlight_handler.c
+ * @brief LEDC PWM driver for the TFT backlight.
+ */
+
+#include "backlight_handler.h"
+#include "driver/ledc.h"
+#include "logger.h"
+#include <stdbool.h>
+
+#define TFT_BACKLIGHT_MODE LEDC_LOW_SPEED_MODE
+#define TFT_BACKLIGHT_TIMER LEDC_TIMER_0
+#define TFT_BACKLIGHT_CHANNEL LEDC_CHANNEL_0
+#define TFT_BACKLIGHT_RESOLUTION LEDC_TIMER_8_BIT
+#define TFT_BACKLIGHT_MAX_DUTY ((1u << TFT_BACKLIGHT_RESOLUTION) - 1)
+
+static const char* TAG = "TFT_BACKLIGHT";
+
+static bool is_backlight_initialized = false;
+
+esp_err_t init_tft_backlight(void)
+{
+    ledc_timer_config_t timer_conf = {
+        .speed_mode = TFT_BACKLIGHT_MODE,
+        .duty_resolution = TFT_BACKLIGHT_RESOLUTION,
+        .timer_num = TFT_BACKLIGHT_TIMER,
+        .freq_hz = TFT_BACKLIGHT_PWM_FREQ,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+
+    esp_err_t err = ledc_timer_config(&timer_conf);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure LEDC timer: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    // The channel takes over the pin from the GPIO output, starting fully on
+    ledc_channel_config_t channel_conf = {
+        .gpio_num = TFT_LED_K_Pin,
+        .speed_mode = TFT_BACKLIGHT_MODE,
+        .channel = TFT_BACKLIGHT_CHANNEL,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = TFT_BACKLIGHT_TIMER,
+        .duty = TFT_BACKLIGHT_MAX_DUTY,
+        .hpoint = 0,
+    };
+
+    err = ledc_channel_config(&channel_conf);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure LEDC channel: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    is_backlight_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t tft_backlight_set(uint8_t percent)
+{
+    if (!is_backlight_initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (percent > 100)
+    {
+        percent = 100;
+    }
+
+    const uint32_t duty = TFT_BACKLIGHT_MAX_DUTY * percent / 100;
+    esp_err_t err = ledc_set_duty(TFT_BACKLIGHT_MODE, TFT_BACKLIGHT_CHANNEL, duty);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    return ledc_update_duty(TFT_BACKLIGHT_MODE, TFT_BACKLIGHT_CHANNEL);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file button_handler.c
+ * @brief GPIO interrupt handler for the user button.
+ */
+
+#include "button_handler.h"
+#include "driver/gpio.h"
+#include "esp_attr.h"
+
+/**
+ * @brief Button interrupt: wakes the task waiting on the semaphore passed as argument.
+ *
+ * @param arg Semaphore given on every edge.
+ */
+static void IRAM_ATTR user_button_isr(void* arg)
+{
+    BaseType_t woken = pdFALSE;
+
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)arg, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+esp_err_t init_user_button(SemaphoreHandle_t event)
+{
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << USER_BUTTON_Pin,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+
+    esp_err_t err = gpio_config(&io_conf);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    // The ISR service may already be installed by another driver
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+    {
+        return err;
+    }
+
+    return gpio_isr_handler_add(USER_BUTTON_Pin, user_button_isr, (void*)event);
+}
+
+bool user_button_pressed(void) { return gpio_get_level(USER_BUTTON_Pin) == 0; }
@@ -3,7 +3,8 @@
  * @brief UART handler for GNSS module communication.
  *
  * This file contains the implementation of the UART handler for the GNSS module.
- * It includes the initialization of the UART interface with the specified parameters.
+ * It includes the initialization of the UART interface with the specified parameters and the
+ * line detection used to hand complete NMEA sentences to the application.
  */
 
 #include "gnss_uart_handler.h"
@@ -18,7 +19,11 @@
  * It sets the baud rate, data bits, parity, stop bits, and flow control.
  * It also sets the TX and RX pins for the UART interface.
  *
- * @return A uart_t structure containing the UART configuration and data queue.
+ * The driver is installed with an event queue and pattern detection on '\n', so the driver
+ * posts a UART_PATTERN_DET event as soon as each NMEA line is complete.
+ *
+ * @return A uart_t structure containing the UART configuration and the driver event queue, or
+ *         one with uart_num set to UART_NUM_MAX if the driver could not be installed.
  */
 
 uart_t init_gnss_uart()
@@ -32,19 +37,87 @@ uart_t init_gnss_uart()
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
         .source_clk = UART_SCLK_DEFAULT,
     };
+    uart_t gnss_uart = {.uart_num = UART_NUM_MAX,
+                        .has_peek = false,
+                        .peek_byte = 0,
+                        .buffered_size = 0,
+                        .data_queue = NULL};
+    QueueHandle_t event_queue;
 
-    // Instalar el controlador de UART
-    uart_driver_install(GNSS_UART, GNSS_UART_BUF_SIZE * 2, 0, 0, NULL, 0);
+    // Instalar el controlador de UART con su cola de eventos
+    if (uart_driver_install(GNSS_UART, GNSS_UART_BUF_SIZE * 2, 0, GNSS_UART_EVENT_QUEUE_SIZE,
+                            &event_queue, 0) != ESP_OK)
+    {
+        return gnss_uart;
+    }
     uart_param_config(GNSS_UART, &uart_config);
     uart_set_pin(GNSS_UART, GNSS_TX_PIN, GNSS_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
 
-    QueueHandle_t data_queue = xQueueCreate(10, sizeof(uint8_t));
-    // Crear y devolver la estructura uart_t
-    uart_t gnss_uart = {.uart_num = GNSS_UART,
-                        .has_peek = false,
-                        .peek_byte = 0,
-                        .buffered_size = 0,
-                        .data_queue = data_queue};
+    // Detectar cada fin de línea: un solo '\n', sin exigir silencio antes ni después
+    if (uart_enable_pattern_det_baud_intr(GNSS_UART, '\n', 1, 9, 0, 0) != ESP_OK ||
+        uart_pattern_queue_reset(GNSS_UART, GNSS_UART_PATTERN_QUEUE_SIZE) != ESP_OK)
+    {
+        uart_driver_delete(GNSS_UART);
+        return gnss_uart;
+    }
 
+    gnss_uart.uart_num = GNSS_UART;
+    gnss_uart.data_queue = event_queue;
     return gnss_uart;
 }
+
+/**
+ * @brief Returns how many bytes to read to reach the end of the next detected line.
+ *
+ * Pops the oldest line end recorded by the pattern detection. If none is recorded (the lines
+ * were already read, or the pattern queue overflowed and dropped positions), returns every
+ * buffered byte instead; the NMEA parser is streaming, so reading past or short of a line end
+ * loses nothing.
+ *
+ * @param uart GNSS UART.
+ * @return Bytes up to and including the '\n', or the bytes buffered.
+ */
+int gnss_uart_line_length(uart_t* uart)
+{
+    const int length = gnss_uart_next_line_length(uart);
+    size_t buffered = 0;
+
+    if (length > 0)
+    {
+        return length;
+    }
+    uart_get_buffered_data_len(uart->uart_num, &buffered);
+    return buffered;
+}
+
+/**
+ * @brief Returns how many bytes to read to reach the end of the next detected line, if any.
+ *
+ * Like gnss_uart_line_length, but without the fallback: once the recorded line ends are used
+ * up it returns 0, so a caller can drain the complete lines without reading a partial one.
+ * Positions are relative to the bytes already read, so it is called after each line is read.
+ *
+ * @param uart GNSS UART.
+ * @return Bytes up to and including the '\n', or 0 if no line end is recorded.
+ */
+int gnss_uart_next_line_length(uart_t* uart)
+{
+    const int position = uart_pattern_pop_pos(uart->uart_num);
+
+    return position >= 0 ? position + 1 : 0;
+}
+
+/**
+ * @brief Discards everything received after an RX overflow.
+ *
+ * Flushes the RX buffer and resets the event and pattern queues, whose positions no longer
+ * match the buffer.
+ *
+ * @param uart GNSS UART.
+ */
+void gnss_uart_reset_input(uart_t* uart)
+{
+    uart_flush_input(uart->uart_num);
+    xQueueReset(uart->data_queue);
+    uart_pattern_queue_reset(uart->uart_num, GNSS_UART_PATTERN_QUEUE_SIZE);
+}
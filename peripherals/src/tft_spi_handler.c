@@ -1,13 +1,29 @@
 #include "tft_spi_handler.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "esp_attr.h"
 #include "logger.h"
+#include <stdint.h>
 
 static const char* TFT_HANDLER = "TFT_SPI";
 
 // Bandera para rastrear si el SPI ya está inicializado
 static bool is_spi_initialized = false;
 
+/**
+ * @brief SPI pre-transfer callback that drives the TFT Data/Command pin.
+ *
+ * Runs in the SPI driver right before each transaction is clocked out. The display driver stores
+ * the DC level in the transaction `user` field (0 = command, 1 = data), so commands and data can
+ * be queued back-to-back without toggling the GPIO from the task.
+ *
+ * @param t Transaction about to be sent.
+ */
+static void IRAM_ATTR tft_spi_pre_transfer_callback(spi_transaction_t* t)
+{
+    gpio_set_level(TFT_DC_Pin, (int)(intptr_t)t->user);
+}
+
 /**
  * @brief Initializes the TFT SPI interface and configures the necessary GPIO pins.
  *
@@ -96,7 +112,7 @@ tft_config_t tft_spi_init(void)
                                             .spics_io_num = tft_pins.cs_pin,
                                             .queue_size = 7,
                                             .flags = SPI_DEVICE_NO_DUMMY,
-                                            .pre_cb = NULL,
+                                            .pre_cb = tft_spi_pre_transfer_callback,
                                             .post_cb = NULL};
 
     ESP_LOGI(TFT_HANDLER, "Adding SPI device...");
@@ -0,0 +1,91 @@
+/**
+ * @file emu_scene.c
+ * @brief Dibuja una escena con todas las primitivas del driver y la vuelca desde el emulador.
+ *
+ * Se compila con y sin framebuffer; las dos variantes deben producir la misma imagen, que
+ * tools/st7735_emu_dump.py compara con tools/golden/primitives.ppm. La escena incluye un mapa
+ * de bits que cruza los bordes de la pantalla, así que ninguna escritura debe quedar fuera del
+ * área visible. Termina con error si el emulador o el bus simulado detectan un problema.
+ */
+
+#include "HT_st7735.h"
+#include "HT_st7735_emu.h"
+#include "mock_spi.h"
+#include <stdio.h>
+
+#define SCENE_IMAGE_SIZE 24
+
+static const uint16_t scene_arrow[16] = {
+    0x0180, 0x03C0, 0x07E0, 0x0FF0, 0x1FF8, 0x3FFC, 0x7FFE, 0xFFFF,
+    0x03C0, 0x03C0, 0x03C0, 0x03C0, 0x03C0, 0x03C0, 0x03C0, 0x03C0,
+};
+
+/* Franjas de colores en RLE: rachas que cruzan filas y un bloque de colores literales */
+static const uint16_t scene_rle_data[] = {
+    0x8000 | 30, ST7735_RED,   0x8000 | 30, ST7735_GREEN, 4,
+    ST7735_WHITE, ST7735_BLACK, ST7735_WHITE, ST7735_BLACK, 0x8000 | 26, ST7735_BLUE,
+};
+
+static const ST7735_RleImage scene_rle = {
+    .width = 10,
+    .height = 9,
+    .length = sizeof(scene_rle_data) / sizeof(scene_rle_data[0]),
+    .data = scene_rle_data,
+};
+
+static const ST7735_Window scene_line = ST7735_WINDOW(0, 70, 69, 79);
+
+int main(void)
+{
+    static uint16_t image[SCENE_IMAGE_SIZE * SCENE_IMAGE_SIZE];
+    ST7735_Config config = {
+        .width = ST7735_WIDTH,
+        .height = ST7735_HEIGHT,
+        .x_start = ST7735_XSTART,
+        .y_start = ST7735_YSTART,
+    };
+
+    // Degradado en el orden de bytes del panel, como lo deja tools/rgb565_rle.py
+    for (int i = 0; i < SCENE_IMAGE_SIZE * SCENE_IMAGE_SIZE; i++)
+    {
+        uint16_t c = ST7735_COLOR565(i * 8, i / 3, (255 - i * 8));
+        image[i] = (uint16_t)((c >> 8) | (c << 8));
+    }
+
+    st7735_init(&config);
+    st7735_fill_screen(&config, ST7735_NAVY);
+    st7735_fill_rectangle(&config, 4, 4, 40, 20, ST7735_RED);
+    st7735_fill_rectangle(&config, 150, 30, 40, 5, ST7735_ORANGE);
+    st7735_write_string(&config, 48, 4, "23.4", Font_11x18, ST7735_YELLOW, ST7735_NAVY);
+    st7735_write_char(&config, 94, 4, 'C', Font_11x18, ST7735_WHITE, ST7735_NAVY);
+    st7735_write_string(&config, 2, 28, "NPK 45 21 118 pH 6.8", Font_7x10, ST7735_WHITE,
+                        ST7735_BLACK);
+    st7735_write_window_text(&config, &scene_line, 1, "Lt: 4.637108", Font_7x10, ST7735_GREEN,
+                             ST7735_BLACK);
+    st7735_draw_image(&config, 110, 42, SCENE_IMAGE_SIZE, SCENE_IMAGE_SIZE, image);
+    st7735_draw_rle_image(&config, 80, 44, &scene_rle);
+    st7735_draw_bitmap_mono(&config, 150, 68, 16, 16, scene_arrow, ST7735_GREEN, ST7735_BLACK);
+    st7735_draw_bitmap_mono(&config, 4, 44, 16, 16, scene_arrow, ST7735_MAGENTA, ST7735_NAVY);
+    for (uint16_t x = 0; x < 40; x += 2)
+    {
+        st7735_draw_pixel(&config, 30 + x, 64, ST7735_CYAN);
+    }
+    st7735_flush(&config);
+
+    st7735_emu_dump("primitives");
+
+    const ST7735_EmuStats emu = st7735_emu_get_stats();
+    const mock_spi_stats_t spi = mock_spi_get_stats();
+    printf("pixel writes %u redundant %u offscreen %u madctl %02x\n", emu.pixel_writes,
+           emu.redundant_writes, emu.offscreen_writes, emu.madctl);
+    printf("spi transactions %u bytes %u queued %u max in flight %u\n", spi.transactions,
+           spi.bytes, spi.queued, spi.max_inflight);
+
+    if (emu.offscreen_writes || emu.madctl != ST7735_ROTATION || spi.overwritten || spi.misuse)
+    {
+        printf("FALLO: offscreen %u overwritten %u misuse %u\n", emu.offscreen_writes,
+               spi.overwritten, spi.misuse);
+        return 1;
+    }
+    return 0;
+}
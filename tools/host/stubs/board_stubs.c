@@ -0,0 +1,24 @@
+/**
+ * @file board_stubs.c
+ * @brief Sustitutos en el PC de los periféricos y colas globales que usa la capa de pantalla.
+ *
+ * El botón nunca está presionado y la luz de fondo acepta cualquier brillo.
+ */
+
+#include "app.h"
+#include "backlight_handler.h"
+#include "button_handler.h"
+#include "esp_system.h"
+
+QueueHandle_t xQueueGNSSData;
+QueueHandle_t xQueueSoilData;
+
+bool user_button_pressed(void) { return false; }
+
+esp_err_t tft_backlight_set(uint8_t percent)
+{
+    (void)percent;
+    return ESP_OK;
+}
+
+uint32_t esp_get_free_heap_size(void) { return 256 * 1024; }
@@ -0,0 +1,13 @@
+/* Sustituto de ESP-IDF para compilar en el PC (tools/host) */
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+typedef int gpio_num_t;
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+int gpio_get_level(gpio_num_t gpio_num);
+
+#endif // HOST_DRIVER_GPIO_H
@@ -0,0 +1,37 @@
+/* Sustituto de ESP-IDF para compilar en el PC (tools/host). Las transacciones las recibe
+ * mock_spi.c */
+#ifndef HOST_DRIVER_SPI_MASTER_H
+#define HOST_DRIVER_SPI_MASTER_H
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define SPI_TRANS_USE_TXDATA (1 << 3)
+
+typedef int spi_host_device_t;
+typedef struct spi_device_t* spi_device_handle_t;
+
+typedef struct
+{
+    uint32_t flags;
+    size_t length; ///< Longitud en bits.
+    void* user;
+    union
+    {
+        const void* tx_buffer;
+        uint8_t tx_data[4];
+    };
+} spi_transaction_t;
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* trans_desc);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans_desc);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans_desc,
+                                 TickType_t ticks_to_wait);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t dev);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans_desc,
+                                      TickType_t ticks_to_wait);
+
+#endif // HOST_DRIVER_SPI_MASTER_H
@@ -0,0 +1,12 @@
+/* Sustituto de ESP-IDF para compilar en el PC (tools/host). Solo los tipos que aparecen en
+ * las cabeceras de la aplicación */
+#ifndef HOST_DRIVER_UART_H
+#define HOST_DRIVER_UART_H
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <stddef.h>
+
+typedef int uart_port_t;
+
+#endif // HOST_DRIVER_UART_H
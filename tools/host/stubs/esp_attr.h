@@ -0,0 +1,10 @@
+/* Sustituto de ESP-IDF para compilar en el PC (tools/host) */
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define DMA_ATTR WORD_ALIGNED_ATTR DRAM_ATTR
+
+#endif // HOST_ESP_ATTR_H
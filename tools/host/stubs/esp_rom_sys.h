@@ -0,0 +1,9 @@
+/* Sustituto de ESP-IDF para compilar en el PC (tools/host) */
+#ifndef HOST_ESP_ROM_SYS_H
+#define HOST_ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+void esp_rom_delay_us(uint32_t us);
+
+#endif // HOST_ESP_ROM_SYS_H
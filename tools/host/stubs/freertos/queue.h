@@ -0,0 +1,15 @@
+/* Sustituto de FreeRTOS para compilar en el PC (tools/host). Las pruebas no crean colas, así
+ * que nunca llega nada */
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_queue* QueueHandle_t;
+typedef struct host_queue* QueueSetHandle_t;
+typedef void* QueueSetMemberHandle_t;
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks_to_wait);
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t set, TickType_t ticks_to_wait);
+
+#endif // HOST_FREERTOS_QUEUE_H
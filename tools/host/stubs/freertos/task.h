@@ -0,0 +1,10 @@
+/* Sustituto de FreeRTOS para compilar en el PC (tools/host) */
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+
+#endif // HOST_FREERTOS_TASK_H
@@ -0,0 +1,17 @@
+/* Sustituto de FreeRTOS para compilar en el PC (tools/host). Los temporizadores nunca
+ * disparan: las pruebas avanzan las animaciones llamando directamente a sus funciones */
+#ifndef HOST_FREERTOS_TIMERS_H
+#define HOST_FREERTOS_TIMERS_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_timer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t timer);
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t auto_reload,
+                           void* timer_id, TimerCallbackFunction_t callback);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks_to_wait);
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks_to_wait);
+void* pvTimerGetTimerID(TimerHandle_t timer);
+
+#endif // HOST_FREERTOS_TIMERS_H
@@ -0,0 +1,169 @@
+/**
+ * @file idf_stubs.c
+ * @brief Implementación en el PC de las funciones de ESP-IDF y FreeRTOS que usa el firmware.
+ *
+ * Hay una sola tarea: un semáforo que no está disponible nunca se liberaría, así que tomarlo
+ * con espera infinita aborta la prueba en lugar de colgarla.
+ */
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+const char* esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    default:
+        return "ESP_FAIL";
+    }
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...)
+{
+    static const char letters[] = "NEWIDV";
+    va_list args;
+
+    printf("%c (%lld) %s: ", letters[level], (long long)(esp_timer_get_time() / 1000), tag);
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    putchar('\n');
+}
+
+void esp_rom_delay_us(uint32_t us) { (void)us; }
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    (void)gpio_num;
+    (void)level;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    (void)gpio_num;
+    return 1;
+}
+
+void vTaskDelay(TickType_t ticks) { (void)ticks; }
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000 / portTICK_PERIOD_MS);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    SemaphoreHandle_t semaphore = calloc(1, sizeof(StaticSemaphore_t));
+    semaphore->max = 1;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer)
+{
+    *buffer = (StaticSemaphore_t){.count = 1, .max = 1};
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait)
+{
+    if (!semaphore->count)
+    {
+        if (ticks_to_wait == portMAX_DELAY)
+        {
+            fprintf(stderr, "xSemaphoreTake: bloqueo sin otra tarea que lo libere\n");
+            abort();
+        }
+        return pdFALSE;
+    }
+    semaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    if (semaphore->count >= semaphore->max)
+    {
+        return pdFALSE;
+    }
+    semaphore->count++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks_to_wait)
+{
+    (void)queue;
+    (void)buffer;
+    (void)ticks_to_wait;
+    return pdFALSE;
+}
+
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t set, TickType_t ticks_to_wait)
+{
+    (void)set;
+    (void)ticks_to_wait;
+    return NULL;
+}
+
+struct host_timer
+{
+    void* id;
+};
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t auto_reload,
+                           void* timer_id, TimerCallbackFunction_t callback)
+{
+    (void)name;
+    (void)period;
+    (void)auto_reload;
+    (void)callback;
+    TimerHandle_t timer = calloc(1, sizeof(*timer));
+    timer->id = timer_id;
+    return timer;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+    (void)timer;
+    (void)ticks_to_wait;
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks_to_wait)
+{
+    (void)timer;
+    (void)period;
+    (void)ticks_to_wait;
+    return pdPASS;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer) { return timer->id; }
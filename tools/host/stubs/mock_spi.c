@@ -0,0 +1,125 @@
+/**
+ * @file mock_spi.c
+ * @brief Bus SPI simulado para ejecutar el driver del ST7735 en el PC.
+ *
+ * Las transacciones terminan al instante, pero las encoladas quedan "en vuelo" hasta que el
+ * driver recoge su resultado, igual que con DMA. Al encolar se guarda un hash del búfer y al
+ * recogerlo se vuelve a calcular: si cambió, el driver escribió un búfer que el DMA todavía
+ * estaba leyendo.
+ */
+
+#include "mock_spi.h"
+#include "driver/spi_master.h"
+
+#define MOCK_SPI_QUEUE_SIZE 8
+
+typedef struct
+{
+    spi_transaction_t* trans;
+    uint32_t hash;
+} mock_spi_pending_t;
+
+static mock_spi_pending_t mock_queue[MOCK_SPI_QUEUE_SIZE];
+static uint32_t mock_head;
+static uint32_t mock_count;
+static mock_spi_stats_t mock_stats;
+
+static const uint8_t* mock_tx_data(const spi_transaction_t* t)
+{
+    return (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : (const uint8_t*)t->tx_buffer;
+}
+
+/**
+ * @brief FNV-1a de los bytes de la transacción.
+ */
+static uint32_t mock_hash(const spi_transaction_t* t)
+{
+    const uint8_t* data = mock_tx_data(t);
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < t->length / 8; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void mock_count_transaction(const spi_transaction_t* t)
+{
+    mock_stats.transactions++;
+    mock_stats.bytes += t->length / 8;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* trans_desc)
+{
+    (void)handle;
+    if (mock_count)
+    {
+        mock_stats.misuse++;
+    }
+    mock_count_transaction(trans_desc);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans_desc)
+{
+    return spi_device_transmit(handle, trans_desc);
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans_desc,
+                                 TickType_t ticks_to_wait)
+{
+    (void)handle;
+    (void)ticks_to_wait;
+    if (mock_count == MOCK_SPI_QUEUE_SIZE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    mock_queue[(mock_head + mock_count) % MOCK_SPI_QUEUE_SIZE] = (mock_spi_pending_t){
+        .trans = trans_desc,
+        .hash = mock_hash(trans_desc),
+    };
+    mock_count++;
+    if (mock_count > mock_stats.max_inflight)
+    {
+        mock_stats.max_inflight = mock_count;
+    }
+    mock_stats.queued++;
+    mock_count_transaction(trans_desc);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans_desc,
+                                      TickType_t ticks_to_wait)
+{
+    (void)handle;
+    (void)ticks_to_wait;
+    if (!mock_count)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    const mock_spi_pending_t* pending = &mock_queue[mock_head];
+    if (mock_hash(pending->trans) != pending->hash)
+    {
+        mock_stats.overwritten++;
+    }
+    *trans_desc = pending->trans;
+    mock_head = (mock_head + 1) % MOCK_SPI_QUEUE_SIZE;
+    mock_count--;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait)
+{
+    (void)device;
+    (void)wait;
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev) { (void)dev; }
+
+mock_spi_stats_t mock_spi_get_stats(void) { return mock_stats; }
+
+void mock_spi_reset_stats(void) { mock_stats = (mock_spi_stats_t){0}; }
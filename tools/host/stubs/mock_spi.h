@@ -0,0 +1,27 @@
+/**
+ * @file mock_spi.h
+ * @brief Bus SPI simulado para ejecutar el driver del ST7735 en el PC.
+ *
+ * Cuenta las transacciones como el bus real y comprueba que el driver no reescriba un búfer
+ * encolado antes de recoger su resultado con spi_device_get_trans_result.
+ */
+
+#ifndef MOCK_SPI_H
+#define MOCK_SPI_H
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t transactions; ///< Transacciones enviadas, síncronas o encoladas.
+    uint32_t bytes;        ///< Bytes enviados.
+    uint32_t queued;       ///< Transacciones encoladas con spi_device_queue_trans.
+    uint32_t max_inflight; ///< Máximo de transacciones encoladas a la vez.
+    uint32_t overwritten;  ///< Búferes modificados mientras estaban encolados.
+    uint32_t misuse;       ///< Transmisiones síncronas con transacciones encoladas pendientes.
+} mock_spi_stats_t;
+
+mock_spi_stats_t mock_spi_get_stats(void);
+void mock_spi_reset_stats(void);
+
+#endif // MOCK_SPI_H
@@ -0,0 +1,134 @@
+/**
+ * @file test_number_formatter.c
+ * @brief Compara number_formatter con snprintf sobre valores aleatorios.
+ *
+ * numfmt_fixed debe producir exactamente lo mismo que "%*.*f" / "%0*.*f" con el valor dividido
+ * por 10^decimals, incluida la truncación cuando el búfer no alcanza. numfmt_scale debe saturar
+ * en lugar de convertir a entero un valor fuera de rango.
+ */
+
+#include "number_formatter.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_VALUES 200000
+
+static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+static int failures;
+
+/* Generador xorshift32 con semilla fija, para que la prueba sea reproducible */
+static uint32_t rng_state = 0x12345678u;
+
+static uint32_t rng_next(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/**
+ * @brief Valor aleatorio con magnitudes repartidas entre 1 y 10 dígitos, y los extremos.
+ */
+static int32_t random_value(void)
+{
+    const uint32_t r = rng_next();
+
+    switch (r % 16)
+    {
+    case 0:
+        return INT32_MIN;
+    case 1:
+        return INT32_MAX;
+    case 2:
+        return 0;
+    default:
+        break;
+    }
+
+    const uint32_t digits = 1 + rng_next() % 10;
+    const uint32_t limit = digits < 10 ? (uint32_t)POW10[digits] : (uint32_t)INT32_MAX;
+    const int32_t value = (int32_t)(rng_next() % limit);
+    return (r & 0x100) ? -value : value;
+}
+
+static void check_fixed(int32_t value, uint8_t decimals, uint8_t width, char pad, size_t size)
+{
+    char expected[64];
+    char actual[64];
+    numfmt_t fmt;
+
+    if (decimals == 0)
+    {
+        snprintf(expected, size, pad == '0' ? "%0*ld" : "%*ld", width, (long)value);
+    }
+    else
+    {
+        snprintf(expected, size, pad == '0' ? "%0*.*f" : "%*.*f", width, decimals,
+                 value / POW10[decimals]);
+    }
+
+    memset(actual, 'x', sizeof(actual));
+    numfmt_init(&fmt, actual, size);
+    numfmt_fixed(&fmt, value, decimals, width, pad);
+
+    if (strcmp(expected, actual) != 0 || fmt.len != strlen(actual))
+    {
+        if (failures++ < 20)
+        {
+            printf("numfmt_fixed(%ld, %u, %u, '%c') size %zu: \"%s\", esperado \"%s\"\n",
+                   (long)value, decimals, width, pad, size, actual, expected);
+        }
+    }
+}
+
+static void check_scale(float value, uint8_t decimals, int32_t expected)
+{
+    int32_t actual = numfmt_scale(value, decimals);
+
+    if (actual != expected)
+    {
+        failures++;
+        printf("numfmt_scale(%g, %u) = %ld, esperado %ld\n", value, decimals, (long)actual,
+               (long)expected);
+    }
+}
+
+int main(void)
+{
+    for (int i = 0; i < TEST_VALUES; i++)
+    {
+        const int32_t value = random_value();
+        const uint8_t decimals = rng_next() % 10;
+        const uint8_t width = rng_next() % 16;
+        const char pad = (rng_next() & 1) ? '0' : ' ';
+        // Uno de cada ocho casos con un búfer que puede quedarse corto
+        const size_t size = (i % 8) ? 64 : 1 + rng_next() % 16;
+
+        check_fixed(value, decimals, width, pad, size);
+    }
+
+    check_scale(21.5f, 1, 215);
+    check_scale(-21.55f, 1, -216);
+    check_scale(4.637108f, 6, 4637108);
+    check_scale(0.0f, 9, 0);
+    check_scale(3.0e9f, 0, INT32_MAX);
+    check_scale(-3.0e9f, 0, INT32_MIN);
+    check_scale(2.2f, 9, INT32_MAX);
+    check_scale(-2.2f, 9, INT32_MIN);
+    check_scale(1.0e30f, 3, INT32_MAX);
+    check_scale(INFINITY, 1, INT32_MAX);
+    check_scale(-INFINITY, 1, INT32_MIN);
+    check_scale(NAN, 1, INT32_MIN);
+
+    if (failures)
+    {
+        printf("%d fallos\n", failures);
+        return 1;
+    }
+    printf("%d valores iguales a snprintf\n", TEST_VALUES);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_tft_widgets.c
+ * @brief Comprueba que el tablero solo redibuja el texto que cambió.
+ *
+ * Cada región de tft_manager recuerda lo último que dibujó. Con los mismos datos solo debe
+ * dibujarse la muestra nueva del gráfico de tendencia; si cambia un solo carácter, solo debe
+ * sumarse ese glifo. Al final, la imagen del emulador tras las actualizaciones parciales debe
+ * ser idéntica a la de un redibujado completo con los mismos datos, salvo en el gráfico: el
+ * redibujado agrega una muestra y el cursor avanza una columna. Antes de todo, ninguna región
+ * debe superponerse con otra de su misma página.
+ */
+
+#include "HT_st7735_emu.h"
+#include "mock_spi.h"
+#include "tft_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Fuente del tablero (TFT_FONT en tft_manager.c) */
+#define GLYPH_PIXELS (7 * 10)
+/* Gráfico de tendencia (SOIL_CHART_WIDTH y SOIL_CHART_HEIGHT en tft_manager.c) */
+#define CHART_X 114
+#define CHART_Y 45
+#define CHART_WIDTH 46
+#define CHART_HEIGHT 35
+
+static TFTElements_t tft_elements;
+static int failures;
+
+static const GNSSData_t test_gnss = {.latitude = 46371080,
+                                     .longitude = -740828130,
+                                     .altitude = 2562.0f,
+                                     .hour = 14,
+                                     .minute = 37,
+                                     .day = 12,
+                                     .month = 10,
+                                     .year = 24,
+                                     .fix_status = 1,
+                                     .satellites_used = 9};
+
+static const SoilData_t test_soil = {.temperature = 23.4f,
+                                     .moisture = 41.7f,
+                                     .conductivity = 312,
+                                     .pH = 6.8f,
+                                     .nitrogen = 45,
+                                     .phosphorus = 21,
+                                     .potassium = 118,
+                                     .status = 1};
+
+/**
+ * @brief Dibuja un cuadro del tablero, lo envía y devuelve lo que costó.
+ */
+static ST7735_Stats render(const GNSSData_t* gnss, const SoilData_t* soil,
+                           mock_spi_stats_t* spi)
+{
+    GNSSData_t gnss_copy = *gnss;
+    SoilData_t soil_copy = *soil;
+    ST7735_Config* config = &tft_elements.tft_config;
+
+    st7735_reset_stats(config);
+    mock_spi_reset_stats();
+    tft_render_frame(&tft_elements, &gnss_copy, &soil_copy);
+    ST7735_Stats stats = st7735_get_stats(config);
+    st7735_flush(config);
+    *spi = mock_spi_get_stats();
+    return stats;
+}
+
+/**
+ * @brief Compara dos imágenes del emulador fuera de la ventana del gráfico.
+ */
+static bool same_outside_chart(const uint16_t* a, const uint16_t* b)
+{
+    for (int y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (int x = 0; x < ST7735_WIDTH; x++)
+        {
+            const bool in_chart = x >= CHART_X && x < CHART_X + CHART_WIDTH && y >= CHART_Y &&
+                                  y < CHART_Y + CHART_HEIGHT;
+            if (!in_chart && a[y * ST7735_WIDTH + x] != b[y * ST7735_WIDTH + x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void expect(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        failures++;
+        printf("FALLO: %s\n", what);
+    }
+}
+
+int main(void)
+{
+    static uint16_t partial[ST7735_WIDTH * ST7735_HEIGHT];
+    ST7735_Config* config = &tft_elements.tft_config;
+    mock_spi_stats_t spi;
+    ST7735_Stats stats;
+
+    expect(tft_layout_check() == 0, "hay regiones superpuestas en una misma página");
+
+    *config = (ST7735_Config){
+        .width = ST7735_WIDTH,
+        .height = ST7735_HEIGHT,
+        .x_start = ST7735_XSTART,
+        .y_start = ST7735_YSTART,
+    };
+    st7735_init(config);
+    st7735_fill_screen(config, ST7735_BLACK);
+    tft_widgets_invalidate();
+
+    stats = render(&test_gnss, &test_soil, &spi);
+    printf("primer cuadro: %u píxeles, %u rectángulos, %u transacciones, %u bytes\n",
+           stats.pixels, stats.rects, spi.transactions, spi.bytes);
+    expect(stats.pixels > 0 && spi.transactions > 0, "el primer cuadro no dibujó nada");
+
+    // Llena el anillo del gráfico: desde aquí cada muestra cuesta dos columnas, la nueva y la
+    // más antigua, que se borra
+    for (int i = 0; i < CHART_WIDTH; i++)
+    {
+        render(&test_gnss, &test_soil, &spi);
+    }
+
+    // Mismos datos: solo cambia el gráfico
+    stats = render(&test_gnss, &test_soil, &spi);
+    printf("mismos datos: %u píxeles, %u rectángulos, %u bytes\n", stats.pixels, stats.rects,
+           spi.bytes);
+    expect(stats.rects == 2 && stats.pixels == 2 * CHART_HEIGHT,
+           "se redibujó texto con los mismos datos");
+
+    // Cambia un solo carácter de la hora (14:37 -> 14:38)
+    GNSSData_t gnss = test_gnss;
+    gnss.minute = 38;
+    stats = render(&gnss, &test_soil, &spi);
+    printf("un minuto más: %u píxeles, %u rectángulos, %u bytes\n", stats.pixels, stats.rects,
+           spi.bytes);
+    expect(stats.rects == 3 && stats.pixels == 2 * CHART_HEIGHT + GLYPH_PIXELS,
+           "cambiar un carácter redibujó más que su glifo");
+
+    // Las actualizaciones parciales dejan la misma imagen que un redibujado completo
+    memcpy(partial, st7735_emu_get_image(), sizeof(partial));
+    st7735_fill_screen(config, ST7735_BLACK);
+    tft_widgets_invalidate();
+    render(&gnss, &test_soil, &spi);
+    expect(same_outside_chart(partial, st7735_emu_get_image()),
+           "la imagen parcial difiere del redibujado completo");
+
+    spi = mock_spi_get_stats();
+    expect(!spi.overwritten && !spi.misuse, "uso incorrecto del bus SPI");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file tft_bench.c
+ * @brief Ejecuta en el PC el benchmark de pantalla (app/src/tft_benchmark.c).
+ *
+ * Las transacciones y los bytes por caso son los mismos que en el ESP32, porque el driver es
+ * el mismo; el tiempo por iteración solo sirve para comparar cambios en el PC, ya que el bus
+ * simulado no tarda nada. Con el emulador activado vuelca además el cuadro "dashboard", que se
+ * compara con tools/golden/dashboard.ppm.
+ */
+
+#include "mock_spi.h"
+#include "tft_benchmark.h"
+#include <stdio.h>
+
+int main(void)
+{
+    static TFTElements_t tft_elements;
+
+    tft_elements.tft_config = (ST7735_Config){
+        .width = ST7735_WIDTH,
+        .height = ST7735_HEIGHT,
+        .x_start = ST7735_XSTART,
+        .y_start = ST7735_YSTART,
+    };
+
+    st7735_init(&tft_elements.tft_config);
+    tft_benchmark_run(&tft_elements);
+
+    const mock_spi_stats_t spi = mock_spi_get_stats();
+    if (spi.overwritten || spi.misuse)
+    {
+        printf("FALLO: overwritten %u misuse %u\n", spi.overwritten, spi.misuse);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Convierte una imagen a un recurso RGB565 comprimido con RLE para st7735_draw_rle_image.
+
+Acepta PPM binario (P6) o PNG de 8 bits RGB/RGBA sin entrelazado y genera un archivo .c con una
+constante ST7735_RleImage. Cada bloque empieza con una cabecera de 16 bits: con el bit 15 en 1 es
+una racha de (cabecera & 0x7FFF) píxeles del color que sigue; con el bit 15 en 0 la siguen
+(cabecera) colores literales. Los colores se guardan en RGB565 normal; el driver los invierte al
+orden de bytes del panel al descomprimir.
+
+Uso:
+    python3 tools/rgb565_rle.py splash.png -n splash_image -o app/src/splash_image.c
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAX_BLOCK = 0x7FFF
+MIN_RUN = 3  # Una racha de 2 ocupa lo mismo que 2 literales y corta el bloque literal.
+
+
+def read_ppm(data):
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos : pos + 1].isspace():
+            pos += 1
+        if data[pos : pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos : pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        raise ValueError("solo se admite PPM P6 con maxval 255")
+    width, height = int(fields[1]), int(fields[2])
+    raw = data[pos + 1 : pos + 1 + width * height * 3]
+    return width, height, [tuple(raw[i : i + 3]) for i in range(0, len(raw), 3)]
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data):
+    pos = 8
+    idat = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos : pos + 8])
+        body = data[pos + 8 : pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+            if depth != 8 or color not in (2, 6) or interlace:
+                raise ValueError("solo se admite PNG RGB/RGBA de 8 bits sin entrelazado")
+            bpp = 3 if color == 2 else 4
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+
+    raw = zlib.decompress(idat)
+    stride = width * bpp
+    prev = bytearray(stride)
+    pixels = []
+    for y in range(height):
+        base = y * (stride + 1)
+        kind = raw[base]
+        line = bytearray(raw[base + 1 : base + 1 + stride])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + prev[i]) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((a + prev[i]) >> 1)) & 0xFF
+            elif kind == 4:
+                line[i] = (line[i] + paeth(a, prev[i], c)) & 0xFF
+        pixels.extend(tuple(line[i : i + 3]) for i in range(0, stride, bpp))
+        prev = line
+    return width, height, pixels
+
+
+def rgb888_to_rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode(pixels):
+    out = []
+    literals = []
+
+    def flush_literals():
+        while literals:
+            block = literals[:MAX_BLOCK]
+            del literals[:MAX_BLOCK]
+            out.append(len(block))
+            out.extend(block)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == pixels[i] and run < MAX_BLOCK:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literals()
+            out.extend((0x8000 | run, pixels[i]))
+        else:
+            literals.extend(pixels[i : i + run])
+        i += run
+    flush_literals()
+    return out
+
+
+def write_source(path, name, width, height, words):
+    with open(path, "w") as f:
+        f.write("/* Generado por tools/rgb565_rle.py; no editar a mano. */\n")
+        f.write('#include "HT_st7735.h"\n\n')
+        f.write("static const uint16_t %s_data[%d] = {\n" % (name, len(words)))
+        for i in range(0, len(words), 12):
+            f.write("    " + ", ".join("0x%04X" % w for w in words[i : i + 12]) + ",\n")
+        f.write("};\n\n")
+        f.write("const ST7735_RleImage %s = {\n" % name)
+        f.write("    .width = %d,\n    .height = %d,\n" % (width, height))
+        f.write("    .length = %d,\n    .data = %s_data,\n};\n" % (len(words), name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="imagen de entrada (.ppm o .png)")
+    parser.add_argument("-n", "--name", help="nombre de la constante generada")
+    parser.add_argument("-o", "--output", help="archivo .c de salida")
+    args = parser.parse_args()
+
+    base = os.path.splitext(os.path.basename(args.image))[0]
+    name = args.name or base.replace("-", "_")
+    output = args.output or base + ".c"
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+    if data.startswith(b"\x89PNG"):
+        width, height, rgb = read_png(data)
+    else:
+        width, height, rgb = read_ppm(data)
+
+    words = encode([rgb888_to_rgb565(*p) for p in rgb])
+    write_source(output, name, width, height, words)
+
+    raw_size = width * height * 2
+    print(
+        "%s: %dx%d, %d -> %d bytes (%.1f%%)"
+        % (name, width, height, raw_size, len(words) * 2, 100.0 * len(words) * 2 / raw_size),
+        file=sys.stderr,
+    )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Reconstruye los cuadros volcados por el emulador del ST7735 (HT_st7735_emu.c).
+
+Lee un log del monitor serie, extrae cada bloque PPM/R/END emitido por st7735_emu_dump y lo
+guarda como .ppm y .png. Con --golden compara cada cuadro con la imagen de referencia del mismo
+nombre y termina con error si algún píxel difiere o si falta la referencia; con --update,
+además, escribe en ese directorio la imagen de cada cuadro como nueva referencia. El emulador ya aplica MADCTL al armar la
+imagen; el valor que acompaña al encabezado PPM es solo informativo.
+
+Las imágenes de referencia de tools/golden/ se generan con el emulador en el PC (tools/host).
+
+Uso:
+    idf.py monitor | tee boot.log
+    python3 tools/st7735_emu_dump.py boot.log -o frames/
+    python3 tools/st7735_emu_dump.py boot.log -o frames/ --golden tools/golden/
+    python3 tools/st7735_emu_dump.py boot.log -o frames/ --golden tools/golden/ --update
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import sys
+import zlib
+
+HEADER = re.compile(r"ST7735_EMU: PPM (\S+) (\d+) (\d+) ([0-9a-fA-F]+)")
+ROW = re.compile(r"ST7735_EMU: R (\d+) ([0-9a-fA-F]+)")
+END = re.compile(r"ST7735_EMU: END (\S+)")
+
+
+def rgb565_to_rgb888(color):
+    r = (color >> 11) & 0x1F
+    g = (color >> 5) & 0x3F
+    b = color & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def parse_frames(lines):
+    frames = {}
+    current = None
+    for line in lines:
+        m = HEADER.search(line)
+        if m:
+            name, width, height = m.group(1), int(m.group(2)), int(m.group(3))
+            current = (name, width, height, [[0] * width for _ in range(height)])
+            continue
+        if current is None:
+            continue
+        m = ROW.search(line)
+        if m:
+            y, data = int(m.group(1)), m.group(2)
+            row = current[3][y]
+            for x in range(min(current[1], len(data) // 4)):
+                row[x] = int(data[x * 4 : x * 4 + 4], 16)
+            continue
+        m = END.search(line)
+        if m and m.group(1) == current[0]:
+            frames[current[0]] = current[1:]
+            current = None
+    return frames
+
+
+def write_ppm(path, width, height, pixels):
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (width, height))
+        for row in pixels:
+            f.write(bytes(c for px in row for c in rgb565_to_rgb888(px)))
+
+
+def write_png(path, width, height, pixels):
+    raw = b"".join(
+        b"\x00" + bytes(c for px in row for c in rgb565_to_rgb888(px)) for row in pixels
+    )
+
+    def chunk(tag, data):
+        body = tag + data
+        return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body))
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, width, height, maxval, body = data.split(maxsplit=4)
+    if magic != b"P6" or maxval != b"255":
+        raise ValueError("%s: solo se admite PPM P6 de 8 bits" % path)
+    return int(width), int(height), body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="log del monitor serie")
+    parser.add_argument("-o", "--output", default=".", help="directorio de salida")
+    parser.add_argument("--golden", help="directorio con las imágenes .ppm de referencia")
+    parser.add_argument(
+        "--update", action="store_true", help="reemplaza las referencias por los cuadros actuales"
+    )
+    args = parser.parse_args()
+    if args.update and not args.golden:
+        parser.error("--update requiere --golden")
+
+    with open(args.log, errors="replace") as f:
+        frames = parse_frames(f)
+    if not frames:
+        sys.exit("no se encontraron cuadros del emulador en %s" % args.log)
+
+    os.makedirs(args.output, exist_ok=True)
+    failed = False
+    for name, (width, height, pixels) in frames.items():
+        ppm = os.path.join(args.output, name + ".ppm")
+        write_ppm(ppm, width, height, pixels)
+        write_png(os.path.join(args.output, name + ".png"), width, height, pixels)
+        print("%s: %dx%d -> %s" % (name, width, height, ppm))
+
+        if args.golden:
+            golden = os.path.join(args.golden, name + ".ppm")
+            if args.update:
+                shutil.copyfile(ppm, golden)
+                print("  referencia actualizada (%s)" % golden)
+                continue
+            if not os.path.exists(golden):
+                print("  sin referencia (%s)" % golden)
+                failed = True
+                continue
+            gw, gh, gbody = read_ppm(golden)
+            _, _, body = read_ppm(ppm)
+            if (gw, gh) != (width, height):
+                print("  tamaño distinto a la referencia: %dx%d" % (gw, gh))
+                failed = True
+                continue
+            diff = sum(1 for i in range(0, len(body), 3) if body[i : i + 3] != gbody[i : i + 3])
+            print("  %d píxeles distintos a la referencia" % diff)
+            failed |= diff > 0
+
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()